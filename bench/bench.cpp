@@ -0,0 +1,557 @@
+#include <sxxlib/is_mesh/topology_operation/topology_operation.h>
+#include <sxxlib/is_mesh/io/io.h>
+#include <jtflib/mesh/io.h>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef __unix__
+#include <sys/resource.h>
+#endif
+
+#define IS_TET_MESH 0
+
+/// the number of the heap allocations, it is counted by the operator new below
+static size_t alloc_num = 0;
+
+/// the operator new counting the heap allocations, new[] calls it too
+void* operator new(std::size_t size)
+{
+#pragma omp atomic
+  ++alloc_num;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if(p == 0)
+    throw std::bad_alloc();
+  return p;
+}
+
+/// the operator delete matching the operator new above
+void operator delete(void* p)
+{
+  std::free(p);
+}
+
+/** This function measures the construction of the mesh with each number of the threads, the wall
+  * time is measured since clock() sums the time of all the threads
+  * \param nodes the coordinates of the vertexes
+  * \param cells the vertex indexes of the top simplexes
+  */
+static void bench_read_scaling(const zjucad::matrix::matrix<double>& nodes,
+                               const zjucad::matrix::matrix<size_t>& cells)
+{
+#ifdef _OPENMP
+  const int proc_num = omp_get_num_procs();
+  for(int thread_num = 1; thread_num <= proc_num; ++thread_num)
+    {
+      omp_set_num_threads(thread_num);
+      is_mesh::mesh bench_mesh;
+      const double begin = omp_get_wtime();
+      is_mesh::io::read_mesh(nodes, cells, bench_mesh);
+      std::cout << "***   read mesh time with " << thread_num << " threads: "
+                << (omp_get_wtime() - begin) * 1000 << " ms   ***" << std::endl;
+    }
+  omp_set_num_threads(proc_num);
+#endif
+}
+
+/** This function measures the import time and the memory of the mesh, the memory of the hash
+  * tables from the vertexes to the handles is reported by dimension, and the top simplexes are
+  * looked up by get_handle
+  * \param nodes the coordinates of the vertexes
+  * \param cells the vertex indexes of the top simplexes
+  */
+static void bench_import(const zjucad::matrix::matrix<double>& nodes,
+                         const zjucad::matrix::matrix<size_t>& cells)
+{
+  is_mesh::mesh import_mesh;
+  is_mesh::timer tr;
+  tr.start();
+  is_mesh::io::read_mesh(nodes, cells, import_mesh);
+  tr.finish();
+  std::cout << "***   import time: " << tr.result() << " ms, mesh memory: "
+            << import_mesh.memory_usage() / 1024 << " KB   ***" << std::endl;
+  const is_mesh::topology_kernel::simplex2handle_type& simplex2handle = import_mesh.get_simplex2handle();
+  for(size_t dim = 1; dim < simplex2handle.size(); ++dim)
+    std::cout << "***   hash table of the " << dim << "-simplexes: " << simplex2handle[dim].size()
+              << " simplexes, " << simplex2handle[dim].memory_usage() / 1024 << " KB   ***" << std::endl;
+
+  std::vector<size_t> verts(cells.size(1));
+  size_t found_num = 0;
+  tr.start();
+  for(size_t i = 0; i < cells.size(2); ++i)
+    {
+      std::copy(&cells(0, i), &cells(0, i) + cells.size(1), verts.begin());
+      std::sort(verts.begin(), verts.end());
+      if(import_mesh.get_handle(verts).id() == i)
+        ++found_num;
+    }
+  tr.finish();
+  std::cout << "***   get_handle: " << tr.result_c() * 1000.0 / cells.size(2) << " ns per lookup, "
+            << found_num << " of " << cells.size(2) << " found   ***" << std::endl;
+}
+
+/** This function compares the jtf loading and the matrix construction with the OBJ reader of is_mesh
+  * with each number of the threads
+  * \param path the file path of the OBJ file
+  */
+static void bench_obj_loading(const char* path)
+{
+#ifdef _OPENMP
+  std::ifstream ifs(path, std::ifstream::binary | std::ifstream::ate);
+  const double file_mb = double(ifs.tellg()) / (1024 * 1024);
+  zjucad::matrix::matrix<double> obj_nodes;
+  zjucad::matrix::matrix<size_t> obj_cells;
+  is_mesh::mesh jtf_mesh;
+  const double begin = omp_get_wtime();
+  jtf::mesh::load_obj(path, obj_cells, obj_nodes);
+  is_mesh::io::read_mesh(obj_nodes, obj_cells, jtf_mesh);
+  const double jtf_time = omp_get_wtime() - begin;
+  std::cout << "***   jtf load_obj + read_mesh: " << jtf_time * 1000 << " ms, "
+            << file_mb / jtf_time << " MB/s   ***" << std::endl;
+  const int proc_num = omp_get_num_procs();
+  for(int thread_num = 1; thread_num <= proc_num; ++thread_num)
+    {
+      is_mesh::mesh obj_mesh;
+      const double obj_begin = omp_get_wtime();
+      is_mesh::io::read_mesh_from_obj(path, obj_mesh, thread_num);
+      const double obj_time = omp_get_wtime() - obj_begin;
+      std::cout << "***   is_mesh read_mesh_from_obj with " << thread_num << " threads: "
+                << obj_time * 1000 << " ms, " << file_mb / obj_time << " MB/s   ***" << std::endl;
+    }
+#endif
+}
+
+/** This function gets the top simplexes around each vertex, it is the traversal measured before
+  * and after the reordering
+  * \return the number of the top simplexes got
+  */
+static size_t sweep_vert_stars(const is_mesh::mesh& cur_mesh)
+{
+  is_mesh::query_context ctx;
+  std::vector<is_mesh::simplex_handle> co_bounds;
+  size_t num = 0;
+  for(size_t i = 0; i < cur_mesh.n_elements(0); ++i)
+    {
+      const is_mesh::simplex_handle vert(0, i);
+      if(cur_mesh.is_simplex_deleted(vert))
+        continue;
+      cur_mesh.get_k_co_boundary_simplex(vert, cur_mesh.top_dim(), co_bounds, ctx);
+      num += co_bounds.size();
+    }
+  return num;
+}
+
+/** This function counts the heap allocations of the boundary, co_boundary and adjacent queries over
+  * every simplex of the mesh. The first sweep grows the query context and the outputs, the second
+  * sweep reuses them and should not allocate.
+  * \param cur_mesh the mesh
+  */
+static void bench_query_allocation(const is_mesh::mesh& cur_mesh)
+{
+  is_mesh::query_context ctx;
+  std::vector<is_mesh::simplex_handle> out;
+  for(size_t sweep = 0; sweep < 2; ++sweep)
+    {
+      const size_t begin_num = alloc_num;
+      size_t query_num = 0;
+      for(size_t dim = 0; dim <= cur_mesh.top_dim(); ++dim)
+        for(size_t i = 0; i < cur_mesh.n_elements(dim); ++i)
+          {
+            const is_mesh::simplex_handle sh(dim, i);
+            if(cur_mesh.is_simplex_deleted(sh))
+              continue;
+            if(dim > 0)
+              {
+                cur_mesh.get_all_boundary_simplex(sh, out, ctx);
+                for(size_t k = 0; k < dim; ++k)
+                  cur_mesh.get_k_boundary_simplex(sh, k, out, ctx);
+                query_num += dim + 1;
+              }
+            if(dim < cur_mesh.top_dim())
+              {
+                cur_mesh.get_all_co_boundary_simplex(sh, out, ctx);
+                for(size_t k = dim + 1; k <= cur_mesh.top_dim(); ++k)
+                  cur_mesh.get_k_co_boundary_simplex(sh, k, out, ctx);
+                query_num += cur_mesh.top_dim() - dim + 1;
+              }
+            cur_mesh.get_adjacent_simplex(sh, out, ctx);
+            ++query_num;
+          }
+      std::cout << "***   query allocations of sweep " << sweep << ": " << alloc_num - begin_num
+                << " in " << query_num << " queries   ***" << std::endl;
+    }
+}
+
+/** This function measures the cost of the property reads. get_simplex_property looks the property
+  * up by its index on each read, while the property resolved once by get_property is indexed
+  * directly. The kernel reads the status of the visited simplexes through resolved properties, so
+  * the cost of a co_boundary query is measured too.
+  * \param nodes the coordinates of the vertexes
+  * \param cells the vertex indexes of the top simplexes
+  */
+static void bench_property_access(const zjucad::matrix::matrix<double>& nodes,
+                                  const zjucad::matrix::matrix<size_t>& cells)
+{
+  // the property is added before the simplexes, so it is resized with them
+  is_mesh::mesh prop_mesh;
+  prop_mesh.set_dim(cells.size(1) - 1);
+  prop_mesh.add_property(0, double(1), "<bench value>");
+  prop_mesh.new_verts(nodes);
+  prop_mesh.new_top_simplices(cells);
+  const size_t prop_id = prop_mesh.get_prop_id(0, double(1), "<bench value>");
+  const size_t vert_num = prop_mesh.n_elements(0);
+  const size_t round_num = 100;
+  is_mesh::property<double>& prop = prop_mesh.get_property<double>(0, prop_id);
+  for(size_t i = 0; i < vert_num; ++i)
+    prop[i] = 1;
+  is_mesh::timer tr;
+  double sum = 0;
+  tr.start();
+  for(size_t round = 0; round < round_num; ++round)
+    for(size_t i = 0; i < vert_num; ++i)
+      sum += prop_mesh.get_simplex_property<double>(is_mesh::simplex_handle(0, i), prop_id);
+  tr.finish();
+  std::cout << "***   get_simplex_property: " << tr.result_c() * 1000.0 / (round_num * vert_num)
+            << " ns per read   ***" << std::endl;
+  tr.start();
+  for(size_t round = 0; round < round_num; ++round)
+    for(size_t i = 0; i < vert_num; ++i)
+      sum += prop[i];
+  tr.finish();
+  std::cout << "***   resolved property: " << tr.result_c() * 1000.0 / (round_num * vert_num)
+            << " ns per read, sum " << sum << "   ***" << std::endl;
+
+  // the queries check the status of each simplex they visit through the resolved status
+  is_mesh::query_context ctx;
+  std::vector<is_mesh::simplex_handle> co_bounds;
+  size_t query_num = 0;
+  tr.start();
+  for(size_t dim = 0; dim < prop_mesh.top_dim(); ++dim)
+    for(size_t i = 0; i < prop_mesh.n_elements(dim); ++i)
+      {
+        const is_mesh::simplex_handle sh(dim, i);
+        if(prop_mesh.is_simplex_deleted(sh))
+          continue;
+        prop_mesh.get_all_co_boundary_simplex(sh, co_bounds, ctx);
+        ++query_num;
+      }
+  tr.finish();
+  std::cout << "***   co_boundary query: " << tr.result_c() * 1000.0 / query_num
+            << " ns per query   ***" << std::endl;
+}
+
+/** This function gets the vertexes of a simplex by the traversal of its boundary, it is the generic
+  * path replaced by the direct indexing of get_simplex_verts
+  * \param cur_mesh the mesh
+  * \param sh the handle of the simplex, its dimension must not be 0
+  * \param visited the visited simplexes of the traversal
+  * \param q the queue of the traversal
+  * \param verts it stores the vertexes of the simplex
+  */
+static void get_verts_by_traversal(const is_mesh::mesh& cur_mesh, const is_mesh::simplex_handle& sh,
+                                   is_mesh::handle_set& visited, is_mesh::handle_queue& q,
+                                   std::vector<is_mesh::simplex_handle>& verts)
+{
+  verts.clear();
+  visited.clear();
+  q.clear();
+  q.push(sh);
+  while(!q.empty())
+    {
+      const is_mesh::simplex_handle cur_sh = q.front();
+      q.pop();
+      const is_mesh::simplex::boundary_type& bounds = cur_mesh.get_specific_simplex(cur_sh).get_boundary();
+      for(size_t i = 0; i < bounds.size(); ++i)
+        if(visited.insert(bounds[i]))
+          {
+            if(bounds[i].dim() == 0)
+              verts.push_back(bounds[i]);
+            else
+              q.push(bounds[i]);
+          }
+    }
+}
+
+/** This function compares the vertexes got by the direct indexing of the boundary with the ones got
+  * by the traversal for the edges, triangles and tets of the mesh
+  * \param cur_mesh the mesh
+  */
+static void bench_simplex_verts(const is_mesh::mesh& cur_mesh)
+{
+  is_mesh::query_context ctx;
+  is_mesh::handle_set visited;
+  is_mesh::handle_queue q;
+  std::vector<is_mesh::simplex_handle> verts, traversal_verts;
+  is_mesh::timer tr;
+  for(size_t dim = 1; dim <= cur_mesh.top_dim(); ++dim)
+    {
+      const size_t num = cur_mesh.n_elements(dim);
+      size_t vert_sum = 0, mismatch_num = 0;
+      tr.start();
+      for(size_t i = 0; i < num; ++i)
+        {
+          cur_mesh.get_k_boundary_simplex(is_mesh::simplex_handle(dim, i), 0, verts, ctx);
+          vert_sum += verts[0].id();
+        }
+      tr.finish();
+      const long direct_time = tr.result_c();
+      tr.start();
+      for(size_t i = 0; i < num; ++i)
+        {
+          get_verts_by_traversal(cur_mesh, is_mesh::simplex_handle(dim, i), visited, q, traversal_verts);
+          vert_sum += traversal_verts[0].id();
+        }
+      tr.finish();
+      for(size_t i = 0; i < num; ++i)
+        {
+          cur_mesh.get_k_boundary_simplex(is_mesh::simplex_handle(dim, i), 0, verts, ctx);
+          get_verts_by_traversal(cur_mesh, is_mesh::simplex_handle(dim, i), visited, q, traversal_verts);
+          std::sort(verts.begin(), verts.end());
+          std::sort(traversal_verts.begin(), traversal_verts.end());
+          if(verts != traversal_verts)
+            ++mismatch_num;
+        }
+      std::cout << "***   vertexes of the " << dim << "-simplexes: direct " << direct_time * 1000.0 / num
+                << " ns, traversal " << tr.result_c() * 1000.0 / num << " ns per simplex, "
+                << mismatch_num << " mismatches, checksum " << vert_sum << "   ***" << std::endl;
+    }
+}
+
+/** This function measures get_k_co_boundary_simplex on the vertexes for each k. The visited simplexes
+  * are marked by the epoch stamps of the query context, so a reused context needs no cleanup, while
+  * a new context grows its stamp arrays again, which is measured on a sample of the vertexes.
+  * \param cur_mesh the mesh
+  */
+static void bench_vert_co_boundary(const is_mesh::mesh& cur_mesh)
+{
+  const size_t vert_num = cur_mesh.n_elements(0);
+  const size_t sample_step = 64;
+  std::vector<is_mesh::simplex_handle> co_bounds;
+  is_mesh::timer tr;
+  for(size_t k = 1; k <= cur_mesh.top_dim(); ++k)
+    {
+      is_mesh::query_context ctx;
+      size_t num = 0;
+      tr.start();
+      for(size_t i = 0; i < vert_num; ++i)
+        {
+          cur_mesh.get_k_co_boundary_simplex(is_mesh::simplex_handle(0, i), k, co_bounds, ctx);
+          num += co_bounds.size();
+        }
+      tr.finish();
+      const long reused_time = tr.result_c();
+      tr.start();
+      for(size_t i = 0; i < vert_num; i += sample_step)
+        {
+          is_mesh::query_context new_ctx;
+          cur_mesh.get_k_co_boundary_simplex(is_mesh::simplex_handle(0, i), k, co_bounds, new_ctx);
+        }
+      tr.finish();
+      std::cout << "***   vertex " << k << "-co_boundary: " << reused_time * 1000.0 / vert_num
+                << " ns per query with a reused context, "
+                << tr.result_c() * 1000.0 * sample_step / vert_num << " ns with a new context, "
+                << num << " simplexes   ***" << std::endl;
+    }
+}
+
+/** This function measures the queries whose candidates are tested by is_belong, which checks that
+  * the sorted vertexes of a simplex are a subset of the ones of the other, for the simplexes of each
+  * dimension. The top co_boundary is checked with get_k_co_boundary_relation.
+  * \param cur_mesh the mesh
+  */
+static void bench_belong_queries(const is_mesh::mesh& cur_mesh)
+{
+  const size_t top_dim = cur_mesh.top_dim();
+  is_mesh::query_context ctx;
+  std::vector<is_mesh::simplex_handle> out;
+  std::vector<size_t> offsets;
+  std::vector<is_mesh::simplex_handle> rows;
+  is_mesh::timer tr;
+  for(size_t dim = 0; dim < top_dim; ++dim)
+    {
+      const size_t num = cur_mesh.n_elements(dim);
+      tr.start();
+      for(size_t i = 0; i < num; ++i)
+        cur_mesh.get_all_co_boundary_simplex(is_mesh::simplex_handle(dim, i), out, ctx);
+      tr.finish();
+      const long all_co_time = tr.result_c();
+      size_t mismatch_num = 0;
+      cur_mesh.get_k_co_boundary_relation(dim, top_dim, offsets, rows);
+      tr.start();
+      for(size_t i = 0; i < num; ++i)
+        {
+          cur_mesh.get_k_co_boundary_simplex(is_mesh::simplex_handle(dim, i), top_dim, out, ctx);
+          if(out.size() != offsets[i + 1] - offsets[i])
+            ++mismatch_num;
+        }
+      tr.finish();
+      const long k_co_time = tr.result_c();
+      tr.start();
+      for(size_t i = 0; i < num; ++i)
+        cur_mesh.get_adjacent_simplex(is_mesh::simplex_handle(dim, i), out, ctx);
+      tr.finish();
+      std::cout << "***   queries of the " << dim << "-simplexes: all co_boundary "
+                << all_co_time * 1000.0 / num << " ns, top co_boundary " << k_co_time * 1000.0 / num
+                << " ns, adjacent " << tr.result_c() * 1000.0 / num << " ns per query, "
+                << mismatch_num << " mismatches   ***" << std::endl;
+    }
+}
+
+/** This function reports the memory of the status packed into bitsets for each dimension, compared
+  * with a simplex_status object for each simplex, and the time of counting the live simplexes word
+  * by word compared with checking them one by one
+  * \param cur_mesh the mesh
+  */
+static void bench_status_memory(const is_mesh::mesh& cur_mesh)
+{
+  size_t packed_bytes = 0, object_bytes = 0;
+  for(size_t dim = 0; dim <= cur_mesh.top_dim(); ++dim)
+    {
+      const int status_id = cur_mesh.get_prop_id(dim, is_mesh::simplex_status(), "<status>");
+      packed_bytes += cur_mesh.get_property<is_mesh::simplex_status>(dim, status_id).memory_usage();
+      object_bytes += cur_mesh.n_elements(dim) * sizeof(is_mesh::simplex_status);
+    }
+  std::cout << "***   status memory: " << packed_bytes / 1024 << " KB packed, "
+            << object_bytes / 1024 << " KB as objects, " << (object_bytes - packed_bytes) / 1024
+            << " KB saved   ***" << std::endl;
+
+  const size_t round_num = 100;
+  size_t live_num = 0;
+  is_mesh::timer tr;
+  tr.start();
+  for(size_t round = 0; round < round_num; ++round)
+    for(size_t dim = 0; dim <= cur_mesh.top_dim(); ++dim)
+      live_num += cur_mesh.n_live_elements(dim);
+  tr.finish();
+  const long word_time = tr.result_c();
+  tr.start();
+  for(size_t round = 0; round < round_num; ++round)
+    for(size_t dim = 0; dim <= cur_mesh.top_dim(); ++dim)
+      for(size_t i = 0; i < cur_mesh.n_elements(dim); ++i)
+        if(!cur_mesh.is_simplex_deleted(is_mesh::simplex_handle(dim, i)))
+          ++live_num;
+  tr.finish();
+  std::cout << "***   live simplex count: " << word_time * 1000.0 / round_num << " ns by words, "
+            << tr.result_c() * 1000.0 / round_num << " ns one by one, " << live_num / (2 * round_num)
+            << " simplexes   ***" << std::endl;
+}
+
+/** This function inserts a vertex at the middle of each edge of the mesh
+  * \param cur_mesh the mesh
+  * \param top_operation the topology operation of the mesh
+  */
+static void split_edges(is_mesh::mesh& cur_mesh, is_mesh::topology_operation& top_operation)
+{
+  std::vector<is_mesh::simplex_handle> bounds;
+  is_mesh::simplex_handle sh;
+  sh.set_dim(1);
+  const size_t num = cur_mesh.n_elements(1);
+  for(size_t i = 0; i < num; ++i)
+    {
+      sh.set_id(i);
+      if(cur_mesh.is_simplex_deleted(sh))
+        continue;
+      is_mesh::coord_type coord(zjucad::matrix::zeros(3, 1));
+      cur_mesh.get_k_boundary_simplex(sh, 0, bounds);
+      for(size_t j = 0; j < bounds.size(); ++j)
+        coord += cur_mesh.get_coord(bounds[j]);
+      coord /= bounds.size();
+      top_operation.insert_vertex(sh, coord);
+    }
+}
+
+int main(int argc, char **argv)
+{
+  if(argc < 2)
+    {
+      std::cerr << "the arguments are less" << std::endl;
+      return 1;
+    }
+
+  zjucad::matrix::matrix<double> nodes;
+  zjucad::matrix::matrix<size_t> cells;
+
+  /********************   read mesh   **********************/
+#if IS_TET_MESH
+  is_mesh::io::tet_mesh_read_from_zjumat(argv[1], &nodes, &cells);
+#else
+  jtf::mesh::load_obj(argv[1], cells, nodes);
+#endif
+
+  /****************   parallel construction scaling   ***************/
+  bench_read_scaling(nodes, cells);
+
+  /****************   import time and memory   ***************/
+  bench_import(nodes, cells);
+
+#if !IS_TET_MESH
+  /****************   parallel obj loading   ***************/
+  bench_obj_loading(argv[1]);
+#endif
+
+  is_mesh::mesh cur_mesh;
+  is_mesh::io::read_mesh(nodes, cells, cur_mesh);
+
+  /****************   queries   ***************/
+  bench_query_allocation(cur_mesh);
+  bench_property_access(nodes, cells);
+  bench_simplex_verts(cur_mesh);
+  bench_vert_co_boundary(cur_mesh);
+  bench_belong_queries(cur_mesh);
+  bench_status_memory(cur_mesh);
+
+  /****************   memory of the operations   ***************/
+  std::cout << "***   mesh memory: " << cur_mesh.memory_usage() / 1024 << " KB   ***" << std::endl;
+  cur_mesh.set_slot_reused(true);
+  is_mesh::topology_operation top_operation(cur_mesh);
+  split_edges(cur_mesh, top_operation);
+  std::cout << "***   mesh memory after operation: " << cur_mesh.memory_usage() / 1024
+            << " KB   ***" << std::endl;
+
+#if !IS_TET_MESH
+  /*******************   flip stress   **************/
+  // each flip deletes and creates two triangles and an edge, the memory does not grow
+  is_mesh::simplex_handle sh;
+  sh.set_dim(1);
+  for(size_t round = 0; round < 5; ++round)
+    {
+      const size_t edge_num = cur_mesh.n_elements(1);
+      for(size_t i = 0; i < edge_num; ++i)
+        {
+          sh.set_id(i);
+          if(!cur_mesh.is_simplex_deleted(sh) && top_operation.is_edge_flip_ok(sh))
+            top_operation.flip_edge(sh);
+        }
+      std::cout << "***   flip round " << round << ", the num of edges: " << cur_mesh.n_elements(1)
+                << ", mesh memory: " << cur_mesh.memory_usage() / 1024 << " KB   ***" << std::endl;
+    }
+#endif
+
+  /*******************   reorder   **************/
+  // the operations scatter the new simplexes in the storage, reordering restores the locality
+  is_mesh::timer tr;
+  tr.start();
+  size_t star_num = sweep_vert_stars(cur_mesh);
+  tr.finish();
+  std::cout << "***   vertex star sweep before reorder: " << tr.result() << " ms, "
+            << star_num << " simplexes   ***" << std::endl;
+  tr.start();
+  cur_mesh.reorder();
+  tr.finish();
+  std::cout << "***   reorder time: " << tr.result() << " ms   ***" << std::endl;
+  tr.start();
+  star_num = sweep_vert_stars(cur_mesh);
+  tr.finish();
+  std::cout << "***   vertex star sweep after reorder: " << tr.result() << " ms, "
+            << star_num << " simplexes   ***" << std::endl;
+
+#ifdef __unix__
+  rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) == 0)
+    std::cout << "***   peak resident memory: " << usage.ru_maxrss << " KB   ***" << std::endl;
+#endif
+
+  return 0;
+}
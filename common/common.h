@@ -8,6 +8,7 @@
 #include <cassert>
 #include <algorithm>
 #include <time.h>
+#include <stdint.h>
 #include <zjucad/matrix/matrix.h>
 
 namespace is_mesh
@@ -17,6 +18,57 @@ namespace is_mesh
   const double ZERO = 1e-10;
 
 
+  /** This function writes a vector of plain old data as the number of the elements followed by
+    * their raw bytes, so the vector is read back by one bulk read
+    * \param os the output stream
+    * \param v the vector to be written
+    * \return 0 if operation suncess othervise non-zero
+    */
+  template <typename T>
+  int write_pod_vector(std::ostream& os, const std::vector<T>& v)
+  {
+    const uint64_t n = v.size();
+    os.write((const char*)&n, sizeof(n));
+    if(n != 0)
+      os.write((const char*)&v[0], sizeof(T) * n);
+    return os.fail();
+  }
+
+  /** This function returns the number of the bytes after the current position of a stream, it is
+    * used to check the sizes read from a file before any memory is allocated
+    * \param is the input stream
+    * \return the number of the remaining bytes, it is -1 if the stream is not seekable
+    */
+  inline uint64_t remaining_bytes(std::istream& is)
+  {
+    const std::streampos pos = is.tellg();
+    if(pos == std::streampos(-1))
+      return uint64_t(-1);
+    is.seekg(0, std::ios::end);
+    const std::streampos end = is.tellg();
+    is.seekg(pos);
+    return end == std::streampos(-1) ? uint64_t(-1) : uint64_t(end - pos);
+  }
+
+  /** This function reads a vector written by write_pod_vector, the number of the elements is
+    * checked against the remaining bytes of a seekable stream before any memory is allocated
+    * \param is the input stream
+    * \param v the vector to be read
+    * \return 0 if operation suncess othervise non-zero
+    */
+  template <typename T>
+  int read_pod_vector(std::istream& is, std::vector<T>& v)
+  {
+    uint64_t n = 0;
+    is.read((char*)&n, sizeof(n));
+    if(is.fail() || remaining_bytes(is) / sizeof(T) < n)
+      return __LINE__;
+    v.resize(n);
+    if(n != 0)
+      is.read((char*)&v[0], sizeof(T) * n);
+    return is.fail();
+  }
+
   class timer{
   public:
     timer():begin_(0), end_(0){}
@@ -25,32 +25,41 @@ int main(int argc, char **argv)
   is_mesh::mesh cur_mesh;
   is_mesh::io::read_mesh(nodes, cells, cur_mesh);
   is_mesh::simplex_handle sh;
+  std::vector<is_mesh::simplex_handle> bounds;
   const size_t top_dim = cur_mesh.top_dim();
 
   /*********************  query example   ********************/
+  // the vertexes of all the simplexes of a dimension are got in one sweep
+  std::vector<size_t> offsets;
+  std::vector<is_mesh::simplex_handle> relation;
   for(size_t dim = 0; dim <= top_dim; ++dim)
     {
-      sh.set_dim(dim);
       size_t n_ele = cur_mesh.n_elements(dim);
       std::cout << "***   the num of dim " << dim
                 << " is: " << n_ele << "   ***" << std::endl;
       if(dim == 0)
         continue;
+      cur_mesh.get_k_boundary_relation(dim, 0, offsets, relation);
       for(size_t j = 0; j < n_ele; ++j)
         {
-          std::vector<is_mesh::simplex_handle> bounds;
-          sh.set_id(j);
-          if(cur_mesh.is_simplex_deleted(sh))
+          if(offsets[j] == offsets[j + 1])
             continue;
-          cur_mesh.get_k_boundary_simplex(sh, 0, bounds);
           std::cout << "dim: " << dim << "  id: " << j << ":   ";
-          for(size_t k = 0; k < bounds.size(); ++k)
-            std::cout << bounds[k].id() << " ";
+          for(size_t k = offsets[j]; k < offsets[j + 1]; ++k)
+            std::cout << relation[k].id() << " ";
           std::cout << std::endl;
         }
     }
 
+  /*******************   adjacent example   **************/
+  // the tets sharing a face, or the triangles sharing an edge
+  cur_mesh.get_adjacent_relation(top_dim, offsets, relation);
+  std::cout << "***   the num of adjacent top simplex pairs is: "
+            << relation.size() / 2 << "   ***" << std::endl;
+
   /*******************   topology operation example   **************/
+  // the slots of the deleted simplexes are reused, so the storage keeps bounded
+  cur_mesh.set_slot_reused(true);
   is_mesh::topology_operation top_operation(cur_mesh);
   const is_mesh::simplex_dim edge_dim = 1;
   const size_t num = cur_mesh.n_elements(edge_dim);
@@ -61,7 +70,6 @@ int main(int argc, char **argv)
       if(cur_mesh.is_simplex_deleted(sh))
         continue;
       is_mesh::coord_type coord(zjucad::matrix::zeros(3, 1));
-      std::vector<is_mesh::simplex_handle> bounds;
       cur_mesh.get_k_boundary_simplex(sh, 0, bounds);
       for(size_t j = 0; j < bounds.size(); ++j)
         coord += cur_mesh.get_coord(bounds[j]);
@@ -71,14 +79,11 @@ int main(int argc, char **argv)
 
 
   /********************  output mesh  ************************/
-  zjucad::matrix::matrix<double> out_nodes;
-  zjucad::matrix::matrix<size_t> out_cells;
-  is_mesh::io::write_mesh(out_nodes, out_cells, cur_mesh);
-
+  // the live simplexes are streamed to the file, the deleted vertexes are not written
 #if IS_TET_MESH
-  io::tet_mesh_write_to_zjumat(argv[2], &out_nodes, &out_cells);
+  is_mesh::io::write_mesh_to_zjumat(argv[2], cur_mesh);
 #else
-  jtf::mesh::save_obj(argv[2], out_cells, out_nodes);
+  is_mesh::io::write_mesh_to_obj(argv[2], cur_mesh);
 #endif
 
   return 0;
@@ -1,69 +1,843 @@
 #include "io.h"
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace is_mesh
 {
   namespace io
   {
     using namespace zjucad::matrix;
 
-    int read_mesh(const matrixd& node, const matrixst& top_simplex, mesh_type &mesh)
+    /// the size of the chunks the files are read in
+    static const size_t READ_CHUNK_SIZE = 1 << 20;
+
+    static bool is_space(char c)
+    {return c == ' ' || c == '\t' || c == '\r';}
+
+    static const char* skip_space(const char* p, const char* last)
     {
-      const simplex_dim top_dim = top_simplex.size(1) - 1;
-      mesh.set_dim(top_dim);
-      simplex_handle sh;
-      for(size_t i = 0; i < node.size(2); ++i)
-        mesh.new_vert(i, node(colon(), i), sh);
+      while(p != last && is_space(*p))
+        ++p;
+      return p;
+    }
+
+    static bool is_digit(char c)
+    {return unsigned(c - '0') < 10;}
 
-      std::vector<size_t> verts(top_dim + 1);
-      for(size_t i = 0; i < top_simplex.size(2); ++i)
+    /** This function parses a floating point number, the numbers with at most 15 significant digits
+      * and a small exponent are converted exactly by one multiplication or division, the others are
+      * given to strtod, so the result is always the same as strtod
+      * \param p the begin of the number, it is moved to the end of the number
+      * \param last the end of the line
+      * \param v the parsed number
+      * \return true if a number is parsed, otherwise false
+      */
+    static bool parse_double(const char*& p, const char* last, double& v)
+    {
+      static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+      const char* first = p;
+      const char* q = p;
+      const bool neg = (q != last && *q == '-');
+      if(q != last && (*q == '-' || *q == '+'))
+        ++q;
+      uint64_t mant = 0;
+      int digits = 0, exp10 = 0;
+      bool is_num = false, is_fast = true;
+      for(; q != last && is_digit(*q); ++q, is_num = true)
+        if(digits < 19)
+          {
+            mant = mant * 10 + (*q - '0');
+            digits += (mant != 0);
+          }
+        else
+          ++exp10;
+      if(q != last && *q == '.')
+        for(++q; q != last && is_digit(*q); ++q, is_num = true)
+          if(digits < 19)
+            {
+              mant = mant * 10 + (*q - '0');
+              digits += (mant != 0);
+              --exp10;
+            }
+      if(q != last && (*q == 'e' || *q == 'E'))
         {
-          for(size_t j = 0; j < verts.size(); ++j)
-            verts[j] = top_simplex[top_simplex.size(1) * i + j];
-          mesh.new_top_simplex(verts, sh);
+          const char* e = q + 1;
+          const bool exp_neg = (e != last && *e == '-');
+          if(e != last && (*e == '-' || *e == '+'))
+            ++e;
+          int exp = 0;
+          is_fast = (e != last && is_digit(*e));
+          for(; e != last && is_digit(*e); ++e)
+            exp = std::min(exp * 10 + (*e - '0'), 100000);
+          exp10 += exp_neg ? -exp : exp;
+          q = e;
         }
-      return 0;
+      if(is_num && is_fast && digits <= 15 && exp10 >= -22 && exp10 <= 22 &&
+         (q == last || is_space(*q)))
+        {
+          v = (exp10 < 0 ? double(mant) / pow10[-exp10] : double(mant) * pow10[exp10]);
+          if(neg)
+            v = -v;
+          p = q;
+          return true;
+        }
+      // the long numbers, inf and nan
+      while(q != last && !is_space(*q))
+        ++q;
+      const std::string token(first, q);
+      char* end = NULL;
+      v = strtod(token.c_str(), &end);
+      p = q;
+      return !token.empty() && end == token.c_str() + token.size();
+    }
+
+    /** This function parses a vertex index of a face, the texture and normal indexes after '/' are
+      * skipped
+      * \param p the begin of the index, it is moved to the end of the index
+      * \param last the end of the line
+      * \param id the parsed index
+      * \return true if an index is parsed, otherwise false
+      */
+    static bool parse_index(const char*& p, const char* last, int64_t& id)
+    {
+      const bool neg = (p != last && *p == '-');
+      if(neg)
+        ++p;
+      if(p == last || !is_digit(*p))
+        return false;
+      for(id = 0; p != last && is_digit(*p); ++p)
+        if(id < (int64_t(1) << 48))
+          id = id * 10 + (*p - '0');
+      if(neg)
+        id = -id;
+      while(p != last && !is_space(*p))
+        {
+          if(*p != '/' && *p != '-' && !is_digit(*p))
+            return false;
+          ++p;
+        }
+      return true;
+    }
+
+    int read_mesh(const matrixd& node, const matrixst& top_simplex, mesh_type &mesh)
+    {
+      const simplex_dim top_dim = top_simplex.size(1) - 1;
+      mesh.set_dim(top_dim);
+      if(mesh.new_verts(node))
+        return __LINE__;
+      return mesh.new_top_simplices(top_simplex);
     }
 
     int write_mesh(matrixd& node, matrixst& top_simplex, const mesh_type &mesh)
     {
       const simplex_manager& sm = mesh.get_simplex_manager();
       simplex_handle cur_sh;
-      cur_sh.set_dim(0);
-      node.resize(3, sm.n_element(0));
-      for(size_t i = 0; i < node.size(2); ++i)
-        {
-          cur_sh.set_id(i);
-          node(zjucad::matrix::colon(), i) = mesh.get_coord(cur_sh);
-        }
+      const coord_view_type coords = mesh.get_coords();
+      node.resize(3, coords.size(2));
+      std::copy(coords.begin(), coords.end(), node.begin());
 
-      size_t top_simplex_num = 0;
+      // the deleted top simplexes are counted and skipped by the words of their flags
       const size_t top_dim = mesh.top_dim();
+      const size_t top_simplex_num = mesh.n_live_elements(top_dim);
       cur_sh.set_dim(top_dim);
-      for(size_t i = 0; i < sm.n_element(top_dim); ++i)
-        {
-          cur_sh.set_id(i);
-          if(!mesh.is_simplex_deleted(cur_sh))
-            ++top_simplex_num;
-        }
       top_simplex.resize(top_dim + 1, top_simplex_num);
       size_t cnt = 0;
-      for(size_t i = 0; i < sm.n_element(top_dim); ++i)
+      simplex_handle verts[MAX_SIMPLEX_DIM + 1];
+      for(size_t i = mesh.next_live_id(top_dim, 0); i < sm.n_element(top_dim);
+          i = mesh.next_live_id(top_dim, i + 1))
         {
           cur_sh.set_id(i);
-          if(!mesh.is_simplex_deleted(cur_sh))
+          if(mesh.is_top_verts_cached())
+            {
+              const size_t* verts = mesh.get_top_simplex_verts(cur_sh);
+              std::copy(verts, verts + top_dim + 1, &top_simplex(0, cnt));
+            }
+          else
             {
-              std::vector<simplex_handle> bounds;
-              mesh.get_k_boundary_simplex(cur_sh, 0, bounds);
-              for(size_t j = 0; j < bounds.size(); ++j)
+              mesh.get_simplex_verts(cur_sh, verts);
+              for(size_t j = 0; j <= top_dim; ++j)
                 {
-                  top_simplex(j, cnt) = bounds[j].id();
+                  top_simplex(j, cnt) = verts[j].id();
                 }
-              ++cnt;
             }
+          ++cnt;
         }
       return 0;
     }
 
+    /** This function parses a line of an OBJ file, the "v" lines are appended to the coordinates
+      * and the "f" lines are appended to the cells, the other lines are skipped
+      * \param p the begin of the line
+      * \param last the end of the line
+      * \param coords the coordinates read so far
+      * \param cells the vertex indexes of the faces read so far
+      * \param cell_size the vertex number of the faces, it is set by the first face if it is 0
+      * \param rel if it is NULL the coordinates hold all the vertexes before the line, otherwise the
+      *        negative indexes are stored relative to the coordinates and their positions in the cells
+      *        are appended to it, they are fixed when the vertex offset is known
+      * \return true if the line is parsed, otherwise false
+      */
+    static bool parse_obj_line(const char* p, const char* last, std::vector<double>& coords,
+                               std::vector<size_t>& cells, size_t& cell_size, std::vector<size_t>* rel)
+    {
+      p = skip_space(p, last);
+      if(last - p < 2 || !is_space(p[1]) || (p[0] != 'v' && p[0] != 'f'))
+        return true;
+      bool is_ok = true;
+      if(p[0] == 'v')
+        {
+          p += 2;
+          for(size_t i = 0; i < 3 && is_ok; ++i)
+            {
+              double x;
+              p = skip_space(p, last);
+              is_ok = parse_double(p, last, x);
+              coords.push_back(x);
+            }
+          return is_ok;
+        }
+      const size_t vert_num = coords.size() / 3;
+      size_t num = 0;
+      for(p = skip_space(p + 2, last); p != last && is_ok; p = skip_space(p, last), ++num)
+        {
+          int64_t id = 0;
+          // the negative indexes count from the last vertex read so far
+          is_ok = parse_index(p, last, id) && id != 0 &&
+              (id > 0 || rel != NULL || uint64_t(-id) <= vert_num);
+          if(id < 0 && rel != NULL)
+            rel->push_back(cells.size());
+          cells.push_back(id > 0 ? size_t(id - 1) : size_t(vert_num + id));
+        }
+      if(cell_size == 0)
+        cell_size = num;
+      return is_ok && num == cell_size && (num == 3 || num == 4);
+    }
+
+    /**
+      * This class maps a file into the memory read-only, the file is read into a buffer if it can not
+      * be mapped, such as on the systems without mmap
+      */
+    class mapped_file
+    {
+    public:
+      mapped_file():data_(NULL), size_(0), is_mapped_(false) {}
+
+      ~mapped_file()
+      {
+#ifdef __unix__
+        if(is_mapped_)
+          munmap((void*)data_, size_);
+#endif
+      }
+
+      /** This function maps the file
+        * \param path the file path
+        * \return 0 if operation suncess othervise non-zero
+        */
+      int open(const char* path)
+      {
+#ifdef __unix__
+        const int fd = ::open(path, O_RDONLY);
+        struct stat st;
+        if(fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0)
+          {
+            void* addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(addr != MAP_FAILED)
+              {
+                data_ = (const char*)addr;
+                size_ = st.st_size;
+                is_mapped_ = true;
+              }
+          }
+        if(fd >= 0)
+          close(fd);
+        if(is_mapped_)
+          return 0;
+#endif
+        std::ifstream ifs(path, std::ifstream::binary);
+        if(ifs.fail())
+          return __LINE__;
+        buf_.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        data_ = buf_.empty() ? NULL : &buf_[0];
+        size_ = buf_.size();
+        return ifs.bad();
+      }
+
+      const char* data() const {return data_;}
+      size_t size() const {return size_;}
+
+    private:
+      mapped_file(const mapped_file&);
+      mapped_file& operator=(const mapped_file&);
+
+      const char* data_;
+      size_t size_;
+      bool is_mapped_;
+      /// the content of the file if it is not mapped
+      std::vector<char> buf_;
+    };
+
+    /// the result of parsing a line-aligned range of an OBJ file
+    struct obj_range
+    {
+      obj_range():cell_size(0), line_num(0), bad_line(0) {}
+
+      /// the coordinates of the "v" lines
+      std::vector<double> coords;
+      /// the vertex indexes of the "f" lines, see parse_obj_line
+      std::vector<size_t> cells;
+      /// the positions of the indexes relative to the vertexes of the range
+      std::vector<size_t> rel;
+      /// the vertex number of the faces, it is 0 if there is no face
+      size_t cell_size;
+      /// the number of the lines
+      size_t line_num;
+      /// the first bad line counted from 1 in the range, it is 0 if all the lines are good
+      size_t bad_line;
+    };
+
+    /// the smallest range of an OBJ file parsed by a thread
+    static const size_t MIN_OBJ_RANGE_SIZE = 1 << 16;
+
+    /// This function reads an OBJ file into the mesh, see read_mesh_from_obj
+    static int read_obj(const char *path, mesh_type& mesh, size_t thread_num)
+    {
+      mapped_file file;
+      if(file.open(path)) {
+        std::cerr << "open " << path << " for read fail." << std::endl;
+        return __LINE__;
+      }
+      const char* data = file.data();
+      const size_t size = file.size();
+
+      // the file is split into more ranges than the threads to balance the load, the range bounds are
+      // moved after the line breaks, so each range has whole lines
+#ifdef _OPENMP
+      if(thread_num == 0)
+        thread_num = omp_get_max_threads();
+#else
+      thread_num = 1;
+#endif
+      size_t range_num = (thread_num == 1 ? 1 : thread_num * 4);
+      range_num = std::max<size_t>(std::min(range_num, size / MIN_OBJ_RANGE_SIZE), 1);
+      std::vector<size_t> bounds(range_num + 1, size);
+      bounds[0] = 0;
+      for(size_t i = 1; i < range_num; ++i)
+        {
+          const size_t begin = std::max(i * (size / range_num), bounds[i - 1]);
+          const char* nl = (begin < size ? (const char*)memchr(data + begin, '\n', size - begin) : NULL);
+          bounds[i] = (nl != NULL ? nl - data + 1 : size);
+        }
+
+      std::vector<obj_range> ranges(range_num);
+#pragma omp parallel for schedule(dynamic) num_threads(thread_num)
+      for(size_t i = 0; i < range_num; ++i)
+        {
+          obj_range& r = ranges[i];
+          const char* p = data + bounds[i];
+          const char* end = data + bounds[i + 1];
+          while(p != end && r.bad_line == 0)
+            {
+              const char* nl = (const char*)memchr(p, '\n', end - p);
+              const char* last = (nl != NULL ? nl : end);
+              ++r.line_num;
+              if(!parse_obj_line(p, last, r.coords, r.cells, r.cell_size, &r.rel))
+                r.bad_line = r.line_num;
+              p = (nl != NULL ? nl + 1 : end);
+            }
+        }
+
+      // the ranges are merged in the file order, the offsets are the prefix sums of their sizes
+      std::vector<size_t> vert_offset(range_num + 1, 0), cell_offset(range_num + 1, 0);
+      size_t cell_size = 0, line_id = 0;
+      for(size_t i = 0; i < range_num; ++i)
+        {
+          const obj_range& r = ranges[i];
+          if(r.bad_line != 0)
+            {
+              std::cerr << "# [error] bad line " << line_id + r.bad_line << " in " << path << std::endl;
+              return __LINE__;
+            }
+          if(r.cell_size != 0 && cell_size != 0 && r.cell_size != cell_size)
+            {
+              std::cerr << "# [error] faces of different sizes in " << path << std::endl;
+              return __LINE__;
+            }
+          if(cell_size == 0)
+            cell_size = r.cell_size;
+          line_id += r.line_num;
+          vert_offset[i + 1] = vert_offset[i] + r.coords.size() / 3;
+          cell_offset[i + 1] = cell_offset[i] + r.cells.size();
+        }
+      if(cell_size == 0)
+        {
+          std::cerr << "# [error] can not read the faces of " << path << std::endl;
+          return __LINE__;
+        }
+      // a single range is taken without the copy
+      const size_t vert_num = vert_offset[range_num];
+      std::vector<double> coords;
+      std::vector<size_t> cells;
+      if(range_num == 1)
+        {
+          coords.swap(ranges[0].coords);
+          cells.swap(ranges[0].cells);
+        }
+      else
+        {
+          coords.resize(3 * vert_num);
+          cells.resize(cell_offset[range_num]);
+        }
+      size_t max_id = 0;
+#pragma omp parallel for schedule(dynamic) num_threads(thread_num) reduction(max:max_id)
+      for(size_t i = 0; i < range_num; ++i)
+        {
+          obj_range& r = ranges[i];
+          std::vector<size_t>& range_cells = (range_num == 1 ? cells : r.cells);
+          for(size_t j = 0; j < r.rel.size(); ++j)
+            range_cells[r.rel[j]] += vert_offset[i];
+          for(size_t j = 0; j < range_cells.size(); ++j)
+            max_id = std::max(max_id, range_cells[j]);
+          if(range_num == 1)
+            continue;
+          std::copy(r.coords.begin(), r.coords.end(), coords.begin() + 3 * vert_offset[i]);
+          std::copy(r.cells.begin(), r.cells.end(), cells.begin() + cell_offset[i]);
+          obj_range().coords.swap(r.coords);
+          obj_range().cells.swap(r.cells);
+        }
+      if(max_id >= vert_num)
+        {
+          std::cerr << "# [error] face index beyond vertex size in " << path << std::endl;
+          return __LINE__;
+        }
+      mesh.set_dim(cell_size - 1);
+      if(mesh.new_verts(coords.empty() ? 0 : &coords[0], vert_num))
+        return __LINE__;
+      std::vector<double>().swap(coords);
+      return mesh.new_top_simplices(cells);
+    }
+
+    int read_mesh_from_obj(const char *path, mesh_type& mesh, size_t thread_num)
+    {
+      const int err = read_obj(path, mesh, thread_num);
+      if(err != 0)
+        mesh.set_dim(0);
+      return err;
+    }
+
+    /** This function reads the sizes of a matrix of a zjumat file, the sizes are checked against the
+      * rest of the stream, so a broken header does not allocate a huge matrix
+      * \param is the input stream
+      * \param min_nrow the minimum number of the rows
+      * \param max_nrow the maximum number of the rows
+      * \param elem_size the size of an element of the matrix
+      * \param nrow it stores the number of the rows
+      * \param ncol it stores the number of the columns
+      * \return 0 if operation suncess othervise non-zero
+      */
+    static int read_matrix_header(std::istream& is, int min_nrow, int max_nrow, size_t elem_size,
+                                  int& nrow, size_t& ncol)
+    {
+      int size[2] = {0, 0};
+      is.read((char*)size, sizeof(size));
+      if(is.fail() || size[0] < min_nrow || size[0] > max_nrow || size[1] < 0 ||
+         remaining_bytes(is) / (size[0] * elem_size) < size_t(size[1]))
+        return __LINE__;
+      nrow = size[0];
+      ncol = size[1];
+      return 0;
+    }
+
+    static int read_matrix_header(std::istream& is, int nrow, size_t elem_size, size_t& ncol)
+    {
+      int row_num = 0;
+      return read_matrix_header(is, nrow, nrow, elem_size, row_num, ncol);
+    }
+
+    /** This function reads the int indexes of a zjumat matrix in chunks and widens them into the
+      * destination, each chunk is checked to be in [0, vert_num) by its maximum as unsigned, so the
+      * negative indexes fail too and the loop has no branch to be vectorized
+      * \param is the input stream
+      * \param num the number of the indexes
+      * \param vert_num the number of the vertexes
+      * \param ids it stores the indexes, its size must be at least num
+      * \return 0 if operation suncess othervise non-zero
+      */
+    static int read_index_chunks(std::istream& is, size_t num, size_t vert_num, size_t* ids)
+    {
+      std::vector<int> buf(std::min(num, READ_CHUNK_SIZE / sizeof(int)));
+      for(size_t i = 0; i < num; )
+        {
+          const size_t n = std::min(buf.size(), num - i);
+          is.read((char*)&buf[0], sizeof(int) * n);
+          if(is.fail())
+            return __LINE__;
+          unsigned int max_id = 0;
+          for(size_t j = 0; j < n; ++j)
+            max_id = std::max(max_id, unsigned(buf[j]));
+          if(size_t(max_id) >= vert_num)
+            return __LINE__;
+          std::copy(buf.begin(), buf.begin() + n, ids + i);
+          i += n;
+        }
+      return 0;
+    }
+
+    /// This function reads a zjumat file into the mesh, see read_mesh_from_zjumat
+    static int read_zjumat(const char *path, mesh_type& mesh)
+    {
+      std::ifstream ifs(path, std::ifstream::binary);
+      if(ifs.fail()) {
+        std::cerr << "open " << path << " for read fail." << std::endl;
+        return __LINE__;
+      }
+
+      // the node matrix stores the coordinates vertex by vertex, they are read into the mesh by chunks
+      // after the rows of the cell matrix give the dimension of the mesh
+      size_t vert_num = 0, cell_num = 0;
+      int cell_size = 0;
+      if(read_matrix_header(ifs, 3, sizeof(double), vert_num))
+        {
+          std::cerr << "# [error] bad node matrix in " << path << std::endl;
+          return __LINE__;
+        }
+      const std::streampos node_pos = ifs.tellg();
+      ifs.seekg(sizeof(double) * 3 * vert_num, std::ios::cur);
+      if(read_matrix_header(ifs, 3, 4, sizeof(int), cell_size, cell_num))
+        {
+          std::cerr << "# [error] bad tet or triangle matrix in " << path << std::endl;
+          return __LINE__;
+        }
+      const std::streampos cell_pos = ifs.tellg();
+      ifs.seekg(node_pos);
+      mesh.set_dim(cell_size - 1);
+      std::vector<double> node_buf(READ_CHUNK_SIZE / sizeof(double) / 3 * 3);
+      for(size_t i = 0; i < vert_num; )
+        {
+          const size_t num = std::min(node_buf.size() / 3, vert_num - i);
+          ifs.read((char*)&node_buf[0], sizeof(double) * 3 * num);
+          if(mesh.new_verts(&node_buf[0], num))
+            return __LINE__;
+          i += num;
+        }
+
+      // the cell matrix is widened to size_t and checked by chunks, then the cells are handed to the
+      // builder without another copy
+      ifs.seekg(cell_pos);
+      std::vector<size_t> cells(cell_size * cell_num);
+      if(read_index_chunks(ifs, cells.size(), vert_num, cells.empty() ? NULL : &cells[0]))
+        {
+          std::cerr << "# [error] cell index beyond vertex size in " << path << std::endl;
+          return __LINE__;
+        }
+      // the boundary triangles after the tets are not needed to build the mesh
+      return mesh.new_top_simplices(cells);
+    }
+
+    int read_mesh_from_zjumat(const char *path, mesh_type& mesh)
+    {
+      const int err = read_zjumat(path, mesh);
+      if(err != 0)
+        mesh.set_dim(0);
+      return err;
+    }
+
+    /**
+      * This class buffers the bytes written to a stream, so the elements of a mesh are written one
+      * by one without a call to the stream for each of them
+      */
+    class chunk_writer
+    {
+    public:
+      chunk_writer(std::ostream& os):os_(os), buf_(READ_CHUNK_SIZE), pos_(0) {}
+
+      ~chunk_writer() {flush();}
+
+      /// This function appends n bytes to the buffer
+      void write(const void* data, size_t n)
+      {
+        if(pos_ + n > buf_.size())
+          flush();
+        if(n > buf_.size())
+          os_.write((const char*)data, n);
+        else
+          {
+            memcpy(&buf_[pos_], data, n);
+            pos_ += n;
+          }
+      }
+
+      /// This function writes the buffer to the stream
+      void flush()
+      {
+        os_.write(&buf_[0], pos_);
+        pos_ = 0;
+      }
+
+    private:
+      std::ostream& os_;
+      std::vector<char> buf_;
+      size_t pos_;
+    };
+
+    /// This class writes a mesh as the node and top simplex matrices of a zjumat file
+    class zjumat_sink
+    {
+    public:
+      zjumat_sink(std::ostream& os):writer_(os) {}
+
+      int begin_verts(size_t vert_num) {return write_header(3, vert_num);}
+
+      void vert(const double* x) {writer_.write(x, 3 * sizeof(double));}
+
+      int begin_cells(size_t cell_num, size_t cell_size) {return write_header(cell_size, cell_num);}
+
+      void cell(const size_t* verts, size_t cell_size)
+      {
+        int ids[MAX_SIMPLEX_DIM + 1];
+        std::copy(verts, verts + cell_size, ids);
+        writer_.write(ids, cell_size * sizeof(int));
+      }
+
+    private:
+      /// the matrix sizes are int, so the larger meshes can not be written
+      int write_header(size_t nrow, size_t ncol)
+      {
+        if(ncol > size_t(std::numeric_limits<int>::max()))
+          return __LINE__;
+        const int header[2] = {int(nrow), int(ncol)};
+        writer_.write(header, sizeof(header));
+        return 0;
+      }
+
+      chunk_writer writer_;
+    };
+
+    /// This class writes a mesh as the "v" and "f" lines of an OBJ file
+    class obj_sink
+    {
+    public:
+      obj_sink(std::ostream& os):writer_(os) {}
+
+      int begin_verts(size_t) {return 0;}
+
+      void vert(const double* x)
+      {
+        char line[3 * 32 + 4] = "v";
+        char* p = line + 1;
+        for(size_t i = 0; i < 3; ++i)
+          {
+            // the shortest of 15 and 17 digits which reads back the same double
+            *p++ = ' ';
+            int len = sprintf(p, "%.15g", x[i]);
+            if(strtod(p, NULL) != x[i])
+              len = sprintf(p, "%.17g", x[i]);
+            p += len;
+          }
+        *p++ = '\n';
+        writer_.write(line, p - line);
+      }
+
+      int begin_cells(size_t, size_t) {return 0;}
+
+      void cell(const size_t* verts, size_t cell_size)
+      {
+        char line[(MAX_SIMPLEX_DIM + 1) * 24 + 4] = "f";
+        char* p = line + 1;
+        for(size_t i = 0; i < cell_size; ++i)
+          {
+            *p++ = ' ';
+            p = format_index(p, verts[i] + 1);
+          }
+        *p++ = '\n';
+        writer_.write(line, p - line);
+      }
+
+    private:
+      /// This function writes the decimal digits of an index and returns the end of them
+      static char* format_index(char* p, size_t id)
+      {
+        char digits[24];
+        size_t n = 0;
+        do
+          {
+            digits[n++] = char('0' + id % 10);
+            id /= 10;
+          }while(id != 0);
+        while(n != 0)
+          *p++ = digits[--n];
+        return p;
+      }
+
+      chunk_writer writer_;
+    };
+
+    /** This function gets the vertex indexes of a top simplex, from the cache if it is enabled
+      * \param mesh the mesh
+      * \param sh the handle of the top simplex
+      * \param ids it stores the top_dim + 1 vertex indexes
+      */
+    static void get_top_verts(const mesh_type& mesh, const simplex_handle& sh, size_t* ids)
+    {
+      if(mesh.is_top_verts_cached())
+        {
+          const size_t* verts = mesh.get_top_simplex_verts(sh);
+          std::copy(verts, verts + sh.dim() + 1, ids);
+          return;
+        }
+      simplex_handle verts[MAX_SIMPLEX_DIM + 1];
+      const size_t num = mesh.get_simplex_verts(sh, verts);
+      for(size_t i = 0; i < num; ++i)
+        ids[i] = verts[i].id();
+    }
+
+    /** This function writes the live top simplexes and the vertexes referenced by them to a sink,
+      * the vertexes are numbered again in the order of their identifiers, so the deleted and the
+      * unreferenced vertexes are dropped. The referenced vertexes are marked in parallel in the first
+      * pass, and the vertexes of the cells are got again in the second pass, from the cache if it is
+      * enabled, so only the vertex map of INDEX is kept. The coordinates are written from the mesh
+      * directly.
+      * \param mesh the mesh
+      * \param sink zjumat_sink or obj_sink
+      * \return 0 if operation suncess othervise non-zero
+      */
+    template <typename INDEX, typename SINK>
+    static int stream_mesh(const mesh_type& mesh, SINK& sink)
+    {
+      const size_t top_dim = mesh.top_dim();
+      const size_t cell_size = top_dim + 1;
+      const size_t top_simplex_size = mesh.get_simplex_manager().n_element(top_dim);
+      const INDEX unused = INDEX(-1);
+      std::vector<INDEX> vert_map(mesh.n_elements(0), unused);
+#pragma omp parallel for
+      for(size_t i = 0; i < top_simplex_size; ++i)
+        {
+          const simplex_handle sh(top_dim, i);
+          if(mesh.is_simplex_deleted(sh))
+            continue;
+          size_t verts[MAX_SIMPLEX_DIM + 1];
+          get_top_verts(mesh, sh, verts);
+          for(size_t j = 0; j < cell_size; ++j)
+            {
+              // all the threads mark a shared vertex with the same value
+#pragma omp atomic write
+              vert_map[verts[j]] = 0;
+            }
+        }
+      INDEX vert_num = 0;
+      for(size_t i = 0; i < vert_map.size(); ++i)
+        if(vert_map[i] != unused)
+          vert_map[i] = vert_num++;
+
+      if(sink.begin_verts(vert_num))
+        return __LINE__;
+      for(size_t i = 0; i < vert_map.size(); ++i)
+        if(vert_map[i] != unused)
+          sink.vert(mesh.get_coord_ptr(simplex_handle(0, i)));
+
+      if(sink.begin_cells(mesh.n_live_elements(top_dim), cell_size))
+        return __LINE__;
+      size_t ids[MAX_SIMPLEX_DIM + 1];
+      for(size_t i = mesh.next_live_id(top_dim, 0); i < top_simplex_size;
+          i = mesh.next_live_id(top_dim, i + 1))
+        {
+          get_top_verts(mesh, simplex_handle(top_dim, i), ids);
+          for(size_t j = 0; j < cell_size; ++j)
+            ids[j] = vert_map[ids[j]];
+          sink.cell(ids, cell_size);
+        }
+      return 0;
+    }
+
+    /// This function streams a mesh with the narrowest index type which holds its vertexes
+    template <typename SINK>
+    static int stream_mesh(const mesh_type& mesh, SINK& sink)
+    {
+      if(mesh.n_elements(0) < size_t(std::numeric_limits<uint32_t>::max()))
+        return stream_mesh<uint32_t>(mesh, sink);
+      return stream_mesh<size_t>(mesh, sink);
+    }
+
+    int write_mesh_to_obj(const char *path, const mesh_type& mesh)
+    {
+      std::ofstream ofs(path, std::ofstream::binary);
+      if(ofs.fail()) {
+        std::cerr << "open " << path << " for write fail." << std::endl;
+        return __LINE__;
+      }
+      {
+        obj_sink sink(ofs);
+        if(stream_mesh(mesh, sink))
+          return __LINE__;
+      }
+      ofs.close();
+      if(ofs.fail()) {
+        std::cerr << "# [error] write " << path << " fail." << std::endl;
+        return __LINE__;
+      }
+      return 0;
+    }
+
+    int write_mesh_to_zjumat(const char *path, const mesh_type& mesh)
+    {
+      std::ofstream ofs(path, std::ofstream::binary);
+      if(ofs.fail()) {
+        std::cerr << "open " << path << " for write fail." << std::endl;
+        return __LINE__;
+      }
+      {
+        zjumat_sink sink(ofs);
+        if(stream_mesh(mesh, sink))
+          {
+            std::cerr << "# [error] the mesh is too large for " << path << std::endl;
+            return __LINE__;
+          }
+      }
+      ofs.close();
+      if(ofs.fail()) {
+        std::cerr << "# [error] write " << path << " fail." << std::endl;
+        return __LINE__;
+      }
+      return 0;
+    }
+
+    int write_snapshot(const char *path, const mesh_type& mesh)
+    {
+      std::ofstream ofs(path, std::ofstream::binary);
+      if(ofs.fail()) {
+        std::cerr << "open " << path << " for write fail." << std::endl;
+        return __LINE__;
+      }
+      if(mesh.save_snapshot(ofs))
+        return __LINE__;
+      ofs.close();
+      return ofs.fail();
+    }
+
+    int read_snapshot(const char *path, mesh_type& mesh)
+    {
+      std::ifstream ifs(path, std::ifstream::binary);
+      if(ifs.fail()) {
+        std::cerr << "open " << path << " for read fail." << std::endl;
+        return __LINE__;
+      }
+      return mesh.load_snapshot(ifs);
+    }
+
     int tet_mesh_read_from_zjumat(const char *path, matrixd *node,
                                   matrixst *tet, matrixst *tri)
     {
@@ -74,21 +848,38 @@ namespace is_mesh
       }
 
       matrixd node0;
-      zjucad::matrix::matrix<int> tet1, tri1;
+      matrixst tet0;
       if(!node) node = &node0;
+      if(!tet) tet = &tet0;
 
-      read_matrix(ifs, *node);
-      read_matrix(ifs, tet1);
-      read_matrix(ifs, tri1);
-      if(tet)
-        *tet = tet1;
-      if(tri)
-        *tri = tri1;
-
-      if(max(*tet) >= node->size(2)){
+      if(read_matrix(ifs, *node) || node->size(1) != 3) {
+        std::cerr << "# [error] bad node matrix in " << path << std::endl;
+        return __LINE__;
+      }
+      // the indexes are widened into the destination matrices while they are checked
+      size_t tet_num = 0;
+      if(read_matrix_header(ifs, 4, sizeof(int), tet_num)) {
+        std::cerr << "# [error] bad tet matrix in " << path << std::endl;
+        return __LINE__;
+      }
+      tet->resize(4, tet_num);
+      if(read_index_chunks(ifs, tet->size(), node->size(2), tet_num == 0 ? NULL : &(*tet)[0])) {
         std::cerr << "# [error] tet index beyond node size " << std::endl;
         return __LINE__;
       }
+      if(!tri)
+        return 0;
+      // the triangle matrix is not written if tet_mesh_write_to_zjumat is called without it
+      size_t tri_num = 0;
+      if(remaining_bytes(ifs) != 0 && read_matrix_header(ifs, 3, sizeof(int), tri_num)) {
+        std::cerr << "# [error] bad tri matrix in " << path << std::endl;
+        return __LINE__;
+      }
+      tri->resize(3, tri_num);
+      if(read_index_chunks(ifs, tri->size(), node->size(2), tri_num == 0 ? NULL : &(*tri)[0])) {
+        std::cerr << "# [error] tri index beyond node size " << std::endl;
+        return __LINE__;
+      }
       return 0;
     }
 
@@ -29,6 +29,48 @@ namespace is_mesh
       */
     int write_mesh(matrixd& node, matrixst& top_simplex, const mesh_type& mesh);
 
+    /// This function reads a mesh from an OBJ file
+    /** This function maps the OBJ file into the memory, splits it into ranges of whole lines and
+      * parses the ranges with the OpenMP threads, the vertexes and faces of the ranges are merged in
+      * the file order, so the mesh does not depend on the number of the threads. The faces with 3
+      * vertexes are triangles and the faces with 4 vertexes are tets, as in the .tet.obj files, the
+      * other lines are skipped
+      * \param path the file path of the OBJ file
+      * \param mesh the mesh which the file is read into
+      * \param thread_num the number of the threads, the OpenMP default is used if it is 0, the file is
+      *        parsed as one range without merging if it is 1
+      * \return 0 if operation suncess othervise non-zero, the mesh is empty on failure
+      */
+    int read_mesh_from_obj(const char *path, mesh_type& mesh, size_t thread_num = 0);
+
+    /// This function reads a tet or triangle mesh from a zjumat file
+    /** This function reads the node and tet matrices written by tet_mesh_write_to_zjumat in chunks,
+      * the vertexes go into the mesh directly and the tets are checked while they are read. A cell
+      * matrix of 3 rows, as write_mesh_to_zjumat writes for a triangle mesh, gives a triangle mesh
+      * \param path the file path of the tet file
+      * \param mesh the mesh which the file is read into
+      * \return 0 if operation suncess othervise non-zero, the mesh is empty on failure
+      */
+    int read_mesh_from_zjumat(const char *path, mesh_type& mesh);
+
+    /// This function writes a mesh to an OBJ file
+    /** This function streams the live top simplexes and the vertexes used by them to the file without
+      * the matrices of the whole mesh, the vertexes are numbered again in the order of their
+      * identifiers, so the deleted and the unreferenced vertexes are not written
+      * \param path the file path of the OBJ file
+      * \param mesh the mesh which is written
+      */
+    int write_mesh_to_obj(const char *path, const mesh_type& mesh);
+
+    /// This function writes a mesh to a zjumat file
+    /** This function streams the mesh as write_mesh_to_obj, the file has the node and top simplex
+      * matrices which read_mesh_from_zjumat reads, the top simplex matrix has top_dim + 1 rows and
+      * the boundary triangle matrix is not written
+      * \param path the file path of the zjumat file
+      * \param mesh the mesh which is written
+      */
+    int write_mesh_to_zjumat(const char *path, const mesh_type& mesh);
+
     /// This function read a tet mesh from file
     /** This function read a tet mesh from file and write the nodes and top simplex into matrix
       * \param path the file path of the tet file
@@ -55,14 +97,36 @@ namespace is_mesh
         matrixst *tet = 0,
         matrixst *tri = 0);
 
+    /// This function writes a snapshot of the mesh into file
+    /** This function writes the whole incidence structure of the mesh, see topology_kernel::save_snapshot,
+      * it is read back by read_snapshot much faster than building the mesh from the top simplexes
+      * \param path the file path of the snapshot
+      * \param mesh the mesh which we want to write out
+      */
+    int write_snapshot(const char *path, const mesh_type& mesh);
+
+    /// This function reads a snapshot of the mesh from file
+    /** This function reads a snapshot written by write_snapshot, see topology_kernel::load_snapshot
+      * \param path the file path of the snapshot
+      * \param mesh the mesh which the snapshot is read into, it is empty on failure
+      */
+    int read_snapshot(const char *path, mesh_type& mesh);
+
     template <typename T>
     int read_matrix(std::istream &is, zjucad::matrix::matrix<T> &m)
     {
-            int nrow, ncol;
+            int nrow = 0, ncol = 0;
             is.read((char *)&nrow, sizeof(int));
             is.read((char *)&ncol, sizeof(int));
+            // the sizes are checked against the rest of the stream before the matrix is allocated
+            if(is.fail() || nrow < 0 || ncol < 0 ||
+               (nrow != 0 && remaining_bytes(is) / sizeof(T) / nrow < size_t(ncol))) {
+                    is.setstate(std::ios::failbit);
+                    return __LINE__;
+            }
             m.resize(nrow, ncol);
-            is.read((char *)&m[0], sizeof(T)*m.size());
+            if(m.size() != 0)
+                    is.read((char *)&m[0], sizeof(T)*m.size());
             return is.fail();
     }
 
@@ -70,7 +134,8 @@ namespace is_mesh
     int read_matrix(std::istream &is, zjucad::matrix::matrix<T> &m, size_t nrow)
     {
             zjucad::matrix::matrix<T> tmp;
-            read_matrix(is, tmp);
+            if(read_matrix(is, tmp))
+                    return __LINE__;
             if((tmp.size() % nrow) != 0)
                     return -1;
             m.resize(nrow, tmp.size()/nrow);
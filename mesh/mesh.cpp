@@ -1,54 +1,83 @@
 #include "mesh.h"
 
+#include <cmath>
+
 namespace is_mesh
 {
+  /// d = a - b
+  static inline void sub3(const double* a, const double* b, double* d)
+  {
+    d[0] = a[0] - b[0];
+    d[1] = a[1] - b[1];
+    d[2] = a[2] - b[2];
+  }
+
+  /// c = a x b
+  static inline void cross3(const double* a, const double* b, double* c)
+  {
+    c[0] = a[1] * b[2] - a[2] * b[1];
+    c[1] = a[2] * b[0] - a[0] * b[2];
+    c[2] = a[0] * b[1] - a[1] * b[0];
+  }
+
+  static inline double dot3(const double* a, const double* b)
+  {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  }
+
   double mesh::get_length(const simplex_handle& sh)
   {
-    using namespace zjucad::matrix;
     assert(is_valid_handle(sh));
     assert(sh.dim() == 1);
-    std::vector<simplex_handle> verts;
-    get_k_boundary_simplex(sh, 0, verts);
-    assert(verts.size() == 2);
-    return norm(get_coord(verts[0]) - get_coord(verts[1]));
+    simplex_handle verts[2];
+    get_simplex_verts(sh, verts);
+    double e[3];
+    sub3(get_coord_ptr(verts[0]), get_coord_ptr(verts[1]), e);
+    return std::sqrt(dot3(e, e));
   }
 
   double mesh::get_area(const simplex_handle& sh)
   {
-    using namespace zjucad::matrix;
     assert(is_valid_handle(sh));
     assert(sh.dim() == 2);
-    std::vector<simplex_handle> verts;
-    get_k_boundary_simplex(sh, 0, verts);
-    assert(verts.size() == 3);
-    return norm(cross(get_coord(verts[1]) - get_coord(verts[0]),
-                      get_coord(verts[2]) - get_coord(verts[0]))) / 2.0;
+    simplex_handle verts[3];
+    get_simplex_verts(sh, verts);
+    const double* v0 = get_coord_ptr(verts[0]);
+    double e1[3], e2[3], n[3];
+    sub3(get_coord_ptr(verts[1]), v0, e1);
+    sub3(get_coord_ptr(verts[2]), v0, e2);
+    cross3(e1, e2, n);
+    return std::sqrt(dot3(n, n)) / 2.0;
   }
 
   double mesh::get_volume(const simplex_handle& sh)
   {
-    using namespace zjucad::matrix;
     assert(is_valid_handle(sh));
     assert(sh.dim() == 3);
-    std::vector<simplex_handle> verts;
-    get_k_boundary_simplex(sh, 0, verts);
-    assert(verts.size() == 4);
-    return dot(cross(get_coord(verts[1]) - get_coord(verts[0]),
-                     get_coord(verts[2]) - get_coord(verts[0])),
-               get_coord(verts[3]) - get_coord(verts[0])) / 6.0;
+    simplex_handle verts[4];
+    get_simplex_verts(sh, verts);
+    const double* v0 = get_coord_ptr(verts[0]);
+    double e1[3], e2[3], e3[3], n[3];
+    sub3(get_coord_ptr(verts[1]), v0, e1);
+    sub3(get_coord_ptr(verts[2]), v0, e2);
+    sub3(get_coord_ptr(verts[3]), v0, e3);
+    cross3(e1, e2, n);
+    return dot3(n, e3) / 6.0;
   }
 
   int mesh::get_face_normal(const simplex_handle& sh, matrixd& face_normal)
   {
-    using namespace zjucad::matrix;
     assert(is_valid_handle(sh));
     assert(sh.dim() == 2);
-    std::vector<simplex_handle> verts;
-    get_k_boundary_simplex(sh, 0, verts);
-    assert(verts.size() == 3);
-    face_normal = cross(get_coord(verts[1]) - get_coord(verts[0]),
-                        get_coord(verts[2]) - get_coord(verts[0]));
-    double len = norm(face_normal);
+    simplex_handle verts[3];
+    get_simplex_verts(sh, verts);
+    const double* v0 = get_coord_ptr(verts[0]);
+    double e1[3], e2[3];
+    face_normal.resize(3, 1);
+    sub3(get_coord_ptr(verts[1]), v0, e1);
+    sub3(get_coord_ptr(verts[2]), v0, e2);
+    cross3(e1, e2, &face_normal[0]);
+    double len = std::sqrt(dot3(&face_normal[0], &face_normal[0]));
     assert(len > ZERO);
     face_normal /= len;
     return 0;
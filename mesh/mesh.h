@@ -27,6 +27,8 @@ namespace is_mesh
       * \param sh the simplex_handle of the given simplex
       * \param prop_id the index of the property
       * \return the property value of the given simplex
+      * \note it does not compile for simplex_status, whose flags are packed into bitsets, use the
+      * is_set_flag, set_flag and set_status of get_property instead
       */
     template<typename T>
     const T& get_simplex_property(const simplex_handle& sh, size_t prop_id) const
@@ -38,6 +40,8 @@ namespace is_mesh
       * \param sh the simplex_handle of the given simplex
       * \param prop_id the index of the property
       * \return the property value of the given simplex
+      * \note it does not compile for simplex_status, whose flags are packed into bitsets, use the
+      * is_set_flag, set_flag and set_status of get_property instead
       */
     template<typename T>
     T& get_simplex_property(const simplex_handle& sh, size_t prop_id)
@@ -46,6 +50,30 @@ namespace is_mesh
     }
 
 
+    /** This function returns the property of the simplexes with given dimension, it is a const version.
+      * Resolve it once and index it by simplex id in loops instead of calling get_simplex_property.
+      * \param dim the dimension of the property
+      * \param prop_id the index of the property
+      * \return the property of the simplexes with given dimension
+      */
+    template<typename T>
+    const property<T>& get_property(const simplex_dim& dim, size_t prop_id) const
+    {
+      return pm_.get_specific_prop<T>(dim, prop_id);
+    }
+
+    /** This function returns the property of the simplexes with given dimension, the reference is
+      * invalidated by set_dim.
+      * \param dim the dimension of the property
+      * \param prop_id the index of the property
+      * \return the property of the simplexes with given dimension
+      */
+    template<typename T>
+    property<T>& get_property(const simplex_dim& dim, size_t prop_id)
+    {
+      return pm_.get_specific_prop<T>(dim, prop_id);
+    }
+
     /** This function returns the given property index
       * \param dim the dimension of the property
       * \param prop a default value of the property
@@ -84,11 +112,8 @@ namespace is_mesh
     {
       const int dim  = verts.size() - 1;
       assert(dim >= 0 && dim <= top_dim_);
-      map_type::const_iterator c_it = simplex2handle_[dim].find(verts);
-      simplex_handle sh;
-      if(c_it != simplex2handle_[dim].end())
-        sh = c_it->second;
-      return sh;
+      assert(!is_collecting_garbage());
+      return simplex2handle_[dim].find(simplex_key(&verts[0], verts.size()));
     }
 
     /** This function return the size of the simplex with the same dimension, be careful, the simplex
@@ -0,0 +1,178 @@
+#ifndef IS_QUERY_CONTEXT_H
+#define IS_QUERY_CONTEXT_H
+
+#include "../simplex/simpex.h"
+
+namespace is_mesh
+{
+  /**
+    * This class is a first-in-first-out queue of simplex handles stored in a vector, the memory
+    * of the vector is kept when the queue is cleared, so it can be reused without allocation.
+    */
+  class handle_queue
+  {
+  public:
+    /// This member function creates a new instance of this class.
+    handle_queue():head_(0) {}
+
+    /// This function clears the queue but keeps its memory
+    void clear()
+    {
+      buf_.clear();
+      head_ = 0;
+    }
+
+    /** This function returns whether the queue is empty
+      * \return true if the queue is empty, otherwise false
+      */
+    bool empty() const
+    {return head_ == buf_.size();}
+
+    /** This function pushes a handle into the back of the queue
+      * \param sh the handle to be pushed
+      */
+    void push(const simplex_handle& sh)
+    {buf_.push_back(sh);}
+
+    /** This function returns the handle at the front of the queue
+      * \return the handle at the front of the queue
+      */
+    const simplex_handle& front() const
+    {
+      assert(!empty());
+      return buf_[head_];
+    }
+
+    /// This function removes the handle at the front of the queue
+    void pop()
+    {
+      assert(!empty());
+      ++head_;
+    }
+
+  private:
+    /// the buffer of the queue, the elements before head_ have been popped
+    std::vector<simplex_handle> buf_;
+
+    /// the position of the front of the queue
+    size_t head_;
+  };
+
+  /**
+    * This class is a set of simplex handles used to mark the simplexes visited by a traversal query.
+    * Each simplex has a stamp in the array of its dimension, and it is in the set if and only if its
+    * stamp equals the current epoch, so clearing the set only increases the epoch and the marks need
+    * no cleanup. The arrays grow on demand and keep their memory for reuse, the array of a dimension
+    * is allocated only when a handle of that dimension is inserted, and it is as long as the largest
+    * id inserted, up to twice of it since it grows by doubling.
+    */
+  class handle_set
+  {
+  public:
+    /// This member function creates a new empty set
+    handle_set():epoch_(1) {}
+
+    /// This function removes all the handles by starting a new epoch
+    void clear()
+    {
+      if(++epoch_ == 0)
+        {
+          // the stamps of the old epochs may equal the new one after wrapping around
+          for(size_t i = 0; i <= MAX_SIMPLEX_DIM; ++i)
+            std::fill(stamps_[i].begin(), stamps_[i].end(), 0);
+          epoch_ = 1;
+        }
+    }
+
+    /** This function returns whether the handle is in the set
+      * \param sh the given handle
+      * \return true if the handle is in the set, otherwise false
+      */
+    bool contains(const simplex_handle& sh) const
+    {
+      assert(sh.dim() <= MAX_SIMPLEX_DIM);
+      const std::vector<uint32_t>& stamps = stamps_[sh.dim()];
+      return sh.id() < stamps.size() && stamps[sh.id()] == epoch_;
+    }
+
+    /** This function inserts the handle into the set
+      * \param sh the given handle, it must not be null
+      * \return true if the handle is inserted, false if it is already in the set
+      */
+    bool insert(const simplex_handle& sh)
+    {
+      assert(!sh.is_null() && sh.dim() <= MAX_SIMPLEX_DIM);
+      std::vector<uint32_t>& stamps = stamps_[sh.dim()];
+      if(sh.id() >= stamps.size())
+        stamps.resize(std::max<size_t>(sh.id() + 1, stamps.size() * 2), 0);
+      if(stamps[sh.id()] == epoch_)
+        return false;
+      stamps[sh.id()] = epoch_;
+      return true;
+    }
+
+  private:
+    /// the stamps of the simplexes of each dimension
+    std::vector<uint32_t> stamps_[MAX_SIMPLEX_DIM + 1];
+
+    /// the current epoch, it is never 0 so the new stamps are not in the set
+    uint32_t epoch_;
+  };
+
+  /**
+    * This class holds the scratch buffers used by the traversal queries of topology_kernel, the
+    * buffers keep their memory between queries, so the queries do not allocate memory once the
+    * buffers have grown. The boundary, co_boundary and adjacent queries have separated buffers.
+    * A context must not be used by two queries at the same time.
+    * The visited simplexes are marked in the context instead of the status of the mesh, so the
+    * queries taking a context are const, and the threads can query the same mesh at the same
+    * time as long as each thread has its own context, for example:
+    * \code
+    * #pragma omp parallel
+    * {
+    *   query_context ctx;
+    *   std::vector<simplex_handle> co_bounds;
+    * #pragma omp for
+    *   for(size_t i = 0; i < vert_num; ++i)
+    *     mesh.get_k_co_boundary_simplex(simplex_handle(0, i), 3, co_bounds, ctx);
+    * }
+    * \endcode
+    * The memory of a context is not small: each of the three visited sets keeps 4 bytes for each
+    * simplex of the dimensions it has visited, so after the queries have touched the whole mesh a
+    * context takes about 12 bytes for each simplex of the mesh, several times of the memory of the
+    * status bits. Therefore a context should be created once for each thread and reused by the
+    * queries rather than created for each query, and it can be destroyed to release the memory.
+    */
+  class query_context
+  {
+  public:
+    /// This member function creates a new instance of this class.
+    query_context() {}
+
+  private:
+    friend class topology_kernel;
+
+    /// the queue used by the boundary queries
+    handle_queue bound_queue_;
+
+    /// the visited simplexes of the boundary queries
+    handle_set bound_visited_;
+
+    /// the k-co_boundary got from the vertex star index
+    std::vector<simplex_handle> star_co_bounds_;
+
+    /// the queue used by the co_boundary queries
+    handle_queue co_bound_queue_;
+
+    /// the visited simplexes of the co_boundary queries
+    handle_set co_bound_visited_;
+
+    /// the queue used by the adjacent query
+    handle_queue adj_queue_;
+
+    /// the visited simplexes of the adjacent query
+    handle_set adj_visited_;
+  };
+}
+
+#endif // IS_QUERY_CONTEXT_H
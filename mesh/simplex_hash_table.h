@@ -0,0 +1,317 @@
+#ifndef IS_SIMPLEX_HASH_TABLE_H
+#define IS_SIMPLEX_HASH_TABLE_H
+
+#include "../simplex/simpex.h"
+
+#include <stdint.h>
+
+namespace is_mesh
+{
+  /**
+    * This class is the key of a simplex in simplex_hash_table, it stores the sorted vertex indexes
+    * of the simplex in a fixed array of 32-bit integers, the unused positions are filled with -1,
+    * so the key is trivially copyable and never allocates memory.
+    */
+  class simplex_key
+  {
+  public:
+    /// the number of vertexes a key can hold
+    static const size_t MAX_VERT_NUM = MAX_SIMPLEX_DIM + 1;
+
+    /// This member function creates a new empty key
+    simplex_key()
+    {
+      for(size_t i = 0; i < MAX_VERT_NUM; ++i)
+        v_[i] = uint32_t(-1);
+    }
+
+    /** This member function creates a key from sorted vertexes
+      * \param verts the sorted vertex indexes
+      * \param n the number of vertexes, it must not be larger than MAX_VERT_NUM
+      */
+    simplex_key(const size_t* verts, size_t n)
+    {
+      assert(n <= MAX_VERT_NUM);
+      for(size_t i = 0; i < n; ++i)
+        {
+          assert(verts[i] < uint32_t(-1));
+          v_[i] = verts[i];
+        }
+      for(size_t i = n; i < MAX_VERT_NUM; ++i)
+        v_[i] = uint32_t(-1);
+    }
+
+    /** This function returns the hash value of the key
+      * \return the hash value of the key
+      */
+    uint64_t hash() const
+    {
+      uint64_t h = (uint64_t(v_[0]) << 32 | v_[1]) * 0x9E3779B97F4A7C15ULL;
+      h ^= (uint64_t(v_[2]) << 32 | v_[3]) + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+      h ^= h >> 31;
+      h *= 0xBF58476D1CE4E5B9ULL;
+      h ^= h >> 29;
+      return h;
+    }
+
+    bool operator== (const simplex_key& rhs) const
+    {
+      return v_[0] == rhs.v_[0] && v_[1] == rhs.v_[1] &&
+          v_[2] == rhs.v_[2] && v_[3] == rhs.v_[3];
+    }
+
+    bool operator!= (const simplex_key& rhs) const
+    {return !(*this == rhs);}
+
+    /** This function returns the i'th vertex of the key
+      * \param i the position of the vertex
+      * \return the i'th vertex index, it is -1 if the position is unused
+      */
+    uint32_t operator[] (size_t i) const
+    {
+      assert(i < MAX_VERT_NUM);
+      return v_[i];
+    }
+
+  private:
+    /// the sorted vertex indexes
+    uint32_t v_[MAX_VERT_NUM];
+  };
+
+  /**
+    * This class maps the sorted vertexes of the simplexes with the same dimension to their handles.
+    * It is an open addressing hash table with linear probing, the keys and the handles are stored
+    * inline in one array whose size is a power of two, a slot whose handle is null is empty. The
+    * erasing shifts the following entries backward, so no tombstone is needed.
+    */
+  class simplex_hash_table
+  {
+  public:
+    /// This member function creates a new empty table
+    simplex_hash_table():size_(0), mask_(0) {}
+
+    /** This function returns the number of the entries
+      * \return the number of the entries
+      */
+    size_t size() const
+    {return size_;}
+
+    /** This function returns whether the table is empty
+      * \return true if the table is empty, otherwise false
+      */
+    bool empty() const
+    {return size_ == 0;}
+
+    /// This function removes all the entries and releases the memory
+    void clear()
+    {
+      std::vector<slot>().swap(slots_);
+      size_ = 0;
+      mask_ = 0;
+    }
+
+    /** This function makes the table hold n entries without rehashing
+      * \param n the number of the entries
+      */
+    void reserve(size_t n)
+    {
+      size_t cap = 16;
+      while(cap * MAX_LOAD_NUM < n * MAX_LOAD_DEN)
+        cap <<= 1;
+      if(cap > slots_.size())
+        rehash(cap);
+    }
+
+    /** This function finds the handle of the given key
+      * \param key the given key
+      * \return the handle of the key, it is null if the key is not found
+      */
+    simplex_handle find(const simplex_key& key) const
+    {
+      if(slots_.empty())
+        return simplex_handle();
+      for(size_t i = key.hash() & mask_; ; i = (i + 1) & mask_)
+        {
+          const slot& s = slots_[i];
+          if(s.sh.is_null())
+            return simplex_handle();
+          if(s.key == key)
+            return s.sh;
+        }
+    }
+
+    /** This function inserts the key with the handle if the key is not in the table
+      * \param key the given key
+      * \param sh the handle of the key, it must not be null
+      * \param exist the handle which is already mapped by the key, it is used when the key exists
+      * \return true if the key is inserted, false if the key exists
+      */
+    bool insert(const simplex_key& key, const simplex_handle& sh, simplex_handle& exist)
+    {
+      assert(!sh.is_null());
+      if((size_ + 1) * MAX_LOAD_DEN > slots_.size() * MAX_LOAD_NUM)
+        rehash(slots_.empty() ? 16 : slots_.size() * 2);
+      size_t i = key.hash() & mask_;
+      for(; !slots_[i].sh.is_null(); i = (i + 1) & mask_)
+        if(slots_[i].key == key)
+          {
+            exist = slots_[i].sh;
+            return false;
+          }
+      slots_[i].key = key;
+      slots_[i].sh = sh;
+      ++size_;
+      return true;
+    }
+
+    /** This function erases the key
+      * \param key the given key
+      * \return true if the key is erased, false if the key is not found
+      */
+    bool erase(const simplex_key& key)
+    {
+      if(slots_.empty())
+        return false;
+      size_t i = key.hash() & mask_;
+      for(; ; i = (i + 1) & mask_)
+        {
+          if(slots_[i].sh.is_null())
+            return false;
+          if(slots_[i].key == key)
+            break;
+        }
+      // shift the following entries of the cluster backward into the hole
+      for(size_t j = (i + 1) & mask_; !slots_[j].sh.is_null(); j = (j + 1) & mask_)
+        {
+          const size_t home = slots_[j].key.hash() & mask_;
+          if(((j - home) & mask_) >= ((j - i) & mask_))
+            {
+              slots_[i] = slots_[j];
+              i = j;
+            }
+        }
+      slots_[i] = slot();
+      --size_;
+      return true;
+    }
+
+    /** This function returns the memory used by the table in bytes
+      * \return the memory used by the table
+      */
+    size_t memory_usage() const
+    {return slots_.capacity() * sizeof(slot);}
+
+    /** This function writes the slots of the table word by word, so they are read back without
+      * rehashing, the key and the handle of a slot take SLOT_WORDS words
+      * \param os the output stream
+      * \return 0 if operation suncess othervise non-zero
+      */
+    int write(std::ostream& os) const
+    {
+      const uint64_t n = slots_.size();
+      os.write((const char*)&n, sizeof(n));
+      std::vector<uint32_t> words(slots_.size() * SLOT_WORDS);
+      for(size_t i = 0; i < slots_.size(); ++i)
+        {
+          uint32_t* w = &words[i * SLOT_WORDS];
+          for(size_t j = 0; j < simplex_key::MAX_VERT_NUM; ++j)
+            w[j] = slots_[i].key[j];
+          w[SLOT_WORDS - 1] = slots_[i].sh.value();
+        }
+      if(!words.empty())
+        os.write((const char*)&words[0], words.size() * sizeof(uint32_t));
+      return os.fail();
+    }
+
+    /** This function reads the table written by write, the slots are only checked to be a table
+      * whose probing stops, the caller checks if they agree with the simplexes
+      * \param is the input stream
+      * \return 0 if operation suncess othervise non-zero, the table is empty on failure
+      */
+    int read(std::istream& is)
+    {
+      uint64_t cap = 0;
+      is.read((char*)&cap, sizeof(cap));
+      clear();
+      if(is.fail() || (cap & (cap - 1)) != 0 || remaining_bytes(is) / (SLOT_WORDS * sizeof(uint32_t)) < cap)
+        return __LINE__;
+      std::vector<slot>(cap).swap(slots_);
+      mask_ = (cap == 0 ? 0 : cap - 1);
+      // the slots are read in chunks, so no copy of the whole table is made
+      std::vector<uint32_t> words(std::min<uint64_t>(cap, 1 << 14) * SLOT_WORDS);
+      size_t ids[simplex_key::MAX_VERT_NUM];
+      for(size_t first = 0; first < cap && !is.fail(); first += words.size() / SLOT_WORDS)
+        {
+          const size_t num = std::min<uint64_t>(cap - first, words.size() / SLOT_WORDS);
+          is.read((char*)&words[0], num * SLOT_WORDS * sizeof(uint32_t));
+          for(size_t i = 0; i < num; ++i)
+            {
+              const uint32_t* w = &words[i * SLOT_WORDS];
+              const uint32_t value = w[SLOT_WORDS - 1];
+              const simplex_handle sh(value >> simplex_handle::ID_BITS, value & simplex_handle::ID_MASK);
+              if(sh.is_null())
+                continue;
+              size_t n = 0;
+              for(; n < simplex_key::MAX_VERT_NUM && w[n] != uint32_t(-1); ++n)
+                ids[n] = w[n];
+              slots_[first + i].key = simplex_key(ids, n);
+              slots_[first + i].sh = sh;
+              ++size_;
+            }
+        }
+      // a free slot must be left, otherwise the probing of a missing key never stops
+      if(is.fail() || (cap != 0 && size_ >= cap))
+        {
+          clear();
+          return __LINE__;
+        }
+      return 0;
+    }
+
+  private:
+    /// the number of the words of a slot in write and read
+    static const size_t SLOT_WORDS = simplex_key::MAX_VERT_NUM + 1;
+
+    /// the maximum load factor is MAX_LOAD_NUM / MAX_LOAD_DEN
+    static const size_t MAX_LOAD_NUM = 7;
+    static const size_t MAX_LOAD_DEN = 10;
+
+    /// an entry of the table
+    struct slot
+    {
+      simplex_key key;
+      simplex_handle sh;
+    };
+
+    /** This function moves all the entries into a new array
+      * \param cap the size of the new array, it must be a power of two
+      */
+    void rehash(size_t cap)
+    {
+      assert((cap & (cap - 1)) == 0 && cap * MAX_LOAD_NUM >= size_ * MAX_LOAD_DEN);
+      std::vector<slot> old(cap);
+      old.swap(slots_);
+      mask_ = cap - 1;
+      for(size_t k = 0; k < old.size(); ++k)
+        {
+          if(old[k].sh.is_null())
+            continue;
+          size_t i = old[k].key.hash() & mask_;
+          while(!slots_[i].sh.is_null())
+            i = (i + 1) & mask_;
+          slots_[i] = old[k];
+        }
+    }
+
+    /// the slots of the table
+    std::vector<slot> slots_;
+
+    /// the number of the entries
+    size_t size_;
+
+    /// the size of slots_ minus one
+    size_t mask_;
+  };
+}
+
+#endif // IS_SIMPLEX_HASH_TABLE_H
@@ -1,101 +1,968 @@
 #include "topology_kernel.h"
 
-#include <queue>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace is_mesh
 {
   void topology_kernel::set_dim(size_t top_dim)
   {
-    for(size_t i = 0; i < top_dim_; ++i)
-      {
-        pm_.clear(i);
-        sm_.clear(i);
-        simplex2handle_[i].clear();
-      }
+    assert(top_dim <= MAX_SIMPLEX_DIM);
+    // the top simplexes are cleared too, so a mesh can be read again
+    for(size_t i = 0; i < pm_.max_dim(); ++i)
+      pm_.clear(i);
+    for(size_t i = 0; i < sm_.max_dim(); ++i)
+      sm_.clear(i);
     simplex2handle_.clear();
+    top_verts_.clear();
+    free_slots_.clear();
+    extra_co_bounds_.clear();
+    clear_vert_star();
 
     top_dim_ = top_dim;
     pm_.set_dim(top_dim);
     sm_.set_dim(top_dim);
     if(top_dim > 0)
       simplex2handle_.resize(top_dim + 1);
+    free_slots_.resize(top_dim + 1);
     for(size_t i = 0; i < top_dim + 1; ++i)
       pm_.add_property(i, simplex_status(), "<status>");
     status_id_ = 0;
-    pm_.add_property(0, coord_type(), "<coordinate>");
+    pm_.add_property(0, vert_coord(), "<coordinate>");
     coord_id_ = 1;
+    bind_props();
+  }
+
+  topology_kernel::topology_kernel(const topology_kernel& rhs)
+    :pm_(rhs.pm_), sm_(rhs.sm_), simplex2handle_(rhs.simplex2handle_),
+      status_id_(rhs.status_id_), coord_id_(rhs.coord_id_), coord_prop_(0), top_dim_(rhs.top_dim_),
+      is_top_verts_cached_(rhs.is_top_verts_cached_), top_verts_(rhs.top_verts_),
+      is_slot_reused_(rhs.is_slot_reused_), free_slots_(rhs.free_slots_),
+      gc_phase_(rhs.gc_phase_), gc_dim_(rhs.gc_dim_), gc_pos_(rhs.gc_pos_),
+      gc_remap_(rhs.gc_remap_), gc_num_(rhs.gc_num_), gc_marks_(rhs.gc_marks_),
+      extra_co_bounds_(rhs.extra_co_bounds_), is_vert_star_built_(rhs.is_vert_star_built_), vert_star_offsets_(rhs.vert_star_offsets_),
+      vert_star_(rhs.vert_star_)
+  {
+    if(rhs.coord_prop_ != 0)
+      bind_props();
+  }
+
+  topology_kernel& topology_kernel::operator= (const topology_kernel& rhs)
+  {
+    if(&rhs != this)
+      {
+        pm_ = rhs.pm_;
+        sm_ = rhs.sm_;
+        simplex2handle_ = rhs.simplex2handle_;
+        status_id_ = rhs.status_id_;
+        coord_id_ = rhs.coord_id_;
+        top_dim_ = rhs.top_dim_;
+        is_top_verts_cached_ = rhs.is_top_verts_cached_;
+        top_verts_ = rhs.top_verts_;
+        is_slot_reused_ = rhs.is_slot_reused_;
+        free_slots_ = rhs.free_slots_;
+        gc_phase_ = rhs.gc_phase_;
+        gc_dim_ = rhs.gc_dim_;
+        gc_pos_ = rhs.gc_pos_;
+        gc_remap_ = rhs.gc_remap_;
+        gc_num_ = rhs.gc_num_;
+        gc_marks_ = rhs.gc_marks_;
+        extra_co_bounds_ = rhs.extra_co_bounds_;
+        is_vert_star_built_ = rhs.is_vert_star_built_;
+        vert_star_offsets_ = rhs.vert_star_offsets_;
+        vert_star_ = rhs.vert_star_;
+        status_props_.clear();
+        coord_prop_ = 0;
+        if(rhs.coord_prop_ != 0)
+          bind_props();
+      }
+    return *this;
+  }
+
+  void topology_kernel::bind_props()
+  {
+    status_props_.resize(top_dim_ + 1);
+    for(size_t i = 0; i < status_props_.size(); ++i)
+      status_props_[i] = &pm_.get_specific_prop<simplex_status>(i, status_id_);
+    coord_prop_ = &pm_.get_specific_prop<vert_coord>(0, coord_id_);
   }
 
   int topology_kernel::new_top_simplex(const std::vector<size_t>& verts, simplex_handle& sh)
   {
+    assert(gc_phase_ == GC_IDLE);
     assert(verts.size() == top_dim_ + 1);
+    size_t sorted_verts[MAX_SIMPLEX_DIM + 1];
+    std::copy(verts.begin(), verts.end(), sorted_verts);
+    return new_sorted_top_simplex(sorted_verts, sh);
+  }
 
-    std::vector<size_t> sorted_verts(verts);
-    std::sort(sorted_verts.begin(), sorted_verts.end());
-    assert(sorted_verts.back() < sm_.n_element(0));
+  int topology_kernel::new_top_simplex(const std::vector<simplex_handle>& verts, simplex_handle& sh)
+  {
+    assert(gc_phase_ == GC_IDLE);
+    assert(verts.size() == top_dim_ + 1);
+    size_t sorted_verts[MAX_SIMPLEX_DIM + 1];
+    for(size_t i = 0; i < verts.size(); ++i)
+      sorted_verts[i] = verts[i].id();
+    return new_sorted_top_simplex(sorted_verts, sh);
+  }
+
+  int topology_kernel::new_sorted_top_simplex(size_t* verts, simplex_handle& sh)
+  {
+    const size_t n = top_dim_ + 1;
+    std::sort(verts, verts + n);
+    assert(verts[n - 1] < sm_.n_element(0));
 
-//    std::cout << "new top simplex: ";
-//    for(size_t i = 0; i < sorted_verts.size(); ++i)
-//        std::cout << sorted_verts[i] << "  ";
-//    std::cout << std::endl;
+    // the k-simplexes of the new top simplex may all be new, they are checked before any of them
+    // is created, so new_tet and new_tri do not fail halfway
+    for(size_t dim = 1; dim < n; ++dim)
+      {
+        size_t num = 1;
+        for(size_t i = 0; i <= dim; ++i)
+          num = num * (n - i) / (i + 1);
+        if(check_id_range(dim, num))
+          return __LINE__;
+      }
 
-    if(sorted_verts.size() == 4)
-      return new_tet(sorted_verts, sh);
-    else if(sorted_verts.size() == 3)
-      return new_tri(sorted_verts, sh);
+    int flg;
+    if(n == 4)
+      flg = new_tet(verts, sh);
+    else if(n == 3)
+      flg = new_tri(verts, sh);
     else
       {
         std::cerr << "the simplex was not supported" << std::endl;
         return __LINE__;
       }
-  }
-
-  int topology_kernel::new_top_simplex(const std::vector<simplex_handle>& verts, simplex_handle& sh)
-  {
-    std::vector<size_t> temp_vert(verts.size());
-    for(size_t i = 0; i < temp_vert.size(); ++i)
-      temp_vert[i] = verts[i].id();
-    return new_top_simplex(temp_vert, sh);
+    clear_vert_star();
+    if(flg == 0 && is_top_verts_cached_)
+      {
+        if(top_verts_.size() < (sh.id() + 1) * n)
+          top_verts_.resize((sh.id() + 1) * n);
+        std::copy(verts, verts + n, top_verts_.begin() + sh.id() * n);
+      }
+    return flg;
   }
 
 
   int topology_kernel::del_simplex(const simplex_handle& sh)
   {
+    assert(gc_phase_ == GC_IDLE);
     assert(is_valid_handle(sh));
     assert(!is_simplex_deleted(sh));
-    std::vector<simplex_handle> co_bounds;
+    if(is_slot_reused_)
+      {
+        // the partial co_boundary of the remaining simplexes still refers the deleted ones
+        std::cerr << "# [error] del_simplex is not allowed while the slots are reused." << std::endl;
+        return __LINE__;
+      }
+    std::vector<simplex_handle>& co_bounds = del_co_bounds_;
     get_all_co_boundary_simplex(sh, co_bounds);
+    // the query may pass the simplexes deleted by the former calls, they are deleted already
     for(size_t i = 0; i < co_bounds.size(); ++i)
+      set_simplex_deleted(co_bounds[i]);
+    set_simplex_deleted(sh);
+    return 0;
+  }
+
+  void topology_kernel::set_simplex_deleted(const simplex_handle& sh)
+  {
+    assert(gc_phase_ == GC_IDLE);
+    if(is_status_set(sh, DELETED))
+      return;
+    set_status_flag(sh, DELETED);
+    if(sh.dim() > 0)
       {
-        assert(!is_simplex_deleted(co_bounds[i]));
-        set_simplex_deleted(co_bounds[i]);
+        // the boundary of a deleted simplex is kept, so its vertexes are still available
+        simplex_handle verts[MAX_SIMPLEX_DIM + 1];
+        size_t ids[MAX_SIMPLEX_DIM + 1];
+        const size_t vert_num = get_simplex_verts(sh, verts);
+        for(size_t i = 0; i < vert_num; ++i)
+          ids[i] = verts[i].id();
+        const simplex_key key(ids, vert_num);
+        if(simplex2handle_[sh.dim()].find(key) == sh)
+          simplex2handle_[sh.dim()].erase(key);
+        remove_extra_co_bound(sh);
+      }
+    if(is_top_verts_cached_ && sh.dim() == top_dim_)
+      std::fill(top_verts_.begin() + sh.id() * (top_dim_ + 1),
+                top_verts_.begin() + (sh.id() + 1) * (top_dim_ + 1), size_t(-1));
+    if(is_slot_reused_)
+      free_slots_[sh.dim()].push_back(sh.id());
+  }
+
+  int topology_kernel::reset_simplex_deleted(const simplex_handle& sh)
+  {
+    assert(gc_phase_ == GC_IDLE);
+    if(!is_status_set(sh, DELETED))
+      return 0;
+    if(sh.dim() == 0)
+      {
+        reset_status_flag(sh, DELETED);
+        return 0;
+      }
+    simplex_handle verts[MAX_SIMPLEX_DIM + 1];
+    size_t ids[MAX_SIMPLEX_DIM + 1];
+    const size_t vert_num = get_simplex_verts(sh, verts);
+    for(size_t i = 0; i < vert_num; ++i)
+      ids[i] = verts[i].id();
+    simplex_handle exist;
+    if(!simplex2handle_[sh.dim()].insert(simplex_key(ids, vert_num), sh, exist))
+      {
+        std::cerr << "# [error] a live simplex with the same vertexes exists: "
+                  << exist.id() << std::endl;
+        return __LINE__;
+      }
+    reset_status_flag(sh, DELETED);
+    if(is_top_verts_cached_ && sh.dim() == top_dim_)
+      std::copy(ids, ids + vert_num, top_verts_.begin() + sh.id() * (top_dim_ + 1));
+    // the facets keeping the extra partial co_boundary get the restored simplex back
+    const simplex::boundary_type& bounds = sm_.get_specific_simplex(sh).get_boundary();
+    for(size_t i = 0; i < bounds.size(); ++i)
+      if(extra_co_bounds_.count(bounds[i]) != 0)
+        set_co_bound_representative(bounds[i], sh);
+    return 0;
+  }
+
+  void topology_kernel::set_co_bound_representative(const simplex_handle& sh, const simplex_handle& co_sh)
+  {
+    assert(is_co_bound_represented(sh.dim()));
+    simplex::par_co_boundary_type& co_bound = sm_.get_specific_simplex(sh).get_par_co_boundary();
+    if(co_bound.empty())
+      {
+        co_bound.push_back(co_sh);
+        return;
+      }
+    if(co_bound[0] == co_sh)
+      return;
+    const extra_co_bound_map::iterator it = extra_co_bounds_.find(sh);
+    if(it != extra_co_bounds_.end())
+      {
+        // the star may be split, so the old representative is kept with the extra ones
+        std::vector<simplex_handle>& extras = it->second;
+        const std::vector<simplex_handle>::iterator pos = std::find(extras.begin(), extras.end(), co_sh);
+        if(pos == extras.end())
+          extras.push_back(co_bound[0]);
+        else
+          *pos = co_bound[0];
+      }
+    co_bound[0] = co_sh;
+  }
+
+  void topology_kernel::remove_extra_co_bound(const simplex_handle& sh)
+  {
+    if(extra_co_bounds_.empty() || !is_co_bound_represented(sh.dim() - 1))
+      return;
+    const simplex::boundary_type& bounds = sm_.get_specific_simplex(sh).get_boundary();
+    for(size_t i = 0; i < bounds.size(); ++i)
+      {
+        const extra_co_bound_map::iterator it = extra_co_bounds_.find(bounds[i]);
+        if(it == extra_co_bounds_.end())
+          continue;
+        std::vector<simplex_handle>& extras = it->second;
+        simplex::par_co_boundary_type& co_bound = sm_.get_specific_simplex(bounds[i]).get_par_co_boundary();
+        const std::vector<simplex_handle>::iterator pos = std::find(extras.begin(), extras.end(), sh);
+        if(pos != extras.end())
+          {
+            *pos = extras.back();
+            extras.pop_back();
+          }
+        else if(!co_bound.empty() && co_bound[0] == sh)
+          {
+            if(extras.empty())
+              co_bound.clear();
+            else
+              {
+                co_bound[0] = extras.back();
+                extras.pop_back();
+              }
+          }
+      }
+  }
+
+  void topology_kernel::set_slot_reused(bool flg)
+  {
+    assert(gc_phase_ == GC_IDLE);
+    is_slot_reused_ = flg;
+    for(size_t i = 0; i < free_slots_.size(); ++i)
+      {
+        std::vector<size_t>().swap(free_slots_[i]);
+        if(!flg)
+          continue;
+        // the smallest identifier is at the back, so it is taken first
+        const property<simplex_status>& status = *status_props_[i];
+        for(size_t j = status.find_next(DELETED, 0, true); j < status.n_elements();
+            j = status.find_next(DELETED, j + 1, true))
+          free_slots_[i].push_back(j);
+        std::reverse(free_slots_[i].begin(), free_slots_[i].end());
+      }
+  }
+
+  size_t topology_kernel::get_free_slot(const simplex_dim& dim)
+  {
+    std::vector<size_t>& slots = free_slots_[dim];
+    while(!slots.empty() && !is_simplex_deleted(simplex_handle(dim, slots.back())))
+      slots.pop_back();
+    return slots.empty() ? size_t(-1) : slots.back();
+  }
+
+  int topology_kernel::check_id_range(const simplex_dim& dim, size_t num) const
+  {
+    // the number of the simplexes never exceeds ID_MASK, so the subtraction does not wrap
+    if(num > simplex_handle::ID_MASK - sm_.n_element(dim))
+      {
+        std::cerr << "# [error] the identifiers of the " << dim
+                  << "-simplexes exceed the range of the handles" << std::endl;
+        return __LINE__;
       }
-    set_simplex_deleted(sh);
     return 0;
   }
 
+  void topology_kernel::set_top_verts_cached(bool flg)
+  {
+    assert(gc_phase_ == GC_IDLE);
+    is_top_verts_cached_ = flg;
+    top_verts_.clear();
+    if(!flg)
+      {
+        std::vector<size_t>().swap(top_verts_);
+        return;
+      }
+    const size_t n = top_dim_ + 1;
+    const size_t top_num = sm_.n_element(top_dim_);
+    top_verts_.resize(top_num * n);
+    simplex_handle verts[MAX_SIMPLEX_DIM + 1];
+    for(size_t i = 0; i < top_num; ++i)
+      {
+        get_simplex_verts(simplex_handle(top_dim_, i), verts);
+        for(size_t j = 0; j < n; ++j)
+          top_verts_[i * n + j] = verts[j].id();
+      }
+  }
+
+  size_t topology_kernel::memory_usage() const
+  {
+    size_t bytes = top_verts_.capacity() * sizeof(size_t);
+    for(size_t i = 0; i <= top_dim_; ++i)
+      bytes += sm_.memory_usage(i) + pm_.memory_usage(i);
+    for(size_t i = 0; i < simplex2handle_.size(); ++i)
+      bytes += simplex2handle_[i].memory_usage();
+    for(size_t i = 0; i < vert_star_.size(); ++i)
+      bytes += vert_star_offsets_[i].capacity() * sizeof(size_t) +
+          vert_star_[i].capacity() * sizeof(simplex_handle);
+    for(extra_co_bound_map::const_iterator it = extra_co_bounds_.begin(); it != extra_co_bounds_.end(); ++it)
+      bytes += sizeof(*it) + it->second.capacity() * sizeof(simplex_handle);
+    return bytes;
+  }
+
+  void topology_kernel::build_vert_star()
+  {
+    assert(gc_phase_ == GC_IDLE);
+    const size_t vert_num = sm_.n_element(0);
+    vert_star_offsets_.resize(top_dim_ + 1);
+    vert_star_.resize(top_dim_ + 1);
+    simplex_handle verts[MAX_SIMPLEX_DIM + 1];
+    for(size_t k = 1; k <= top_dim_; ++k)
+      {
+        // count the k-simplexes of each vertex, then fill them in the order of their identifiers
+        std::vector<size_t>& offsets = vert_star_offsets_[k];
+        std::vector<simplex_handle>& star = vert_star_[k];
+        offsets.assign(vert_num + 1, 0);
+        const size_t n = sm_.n_element(k);
+        for(size_t i = 0; i < n; ++i)
+          {
+            const simplex_handle sh(k, i);
+            if(is_simplex_deleted(sh))
+              continue;
+            get_simplex_verts(sh, verts);
+            for(size_t j = 0; j <= k; ++j)
+              ++offsets[verts[j].id() + 1];
+          }
+        for(size_t i = 0; i < vert_num; ++i)
+          offsets[i + 1] += offsets[i];
+        star.resize(offsets[vert_num]);
+        std::vector<size_t> pos(offsets.begin(), offsets.end() - 1);
+        for(size_t i = 0; i < n; ++i)
+          {
+            const simplex_handle sh(k, i);
+            if(is_simplex_deleted(sh))
+              continue;
+            get_simplex_verts(sh, verts);
+            for(size_t j = 0; j <= k; ++j)
+              star[pos[verts[j].id()]++] = sh;
+          }
+      }
+    is_vert_star_built_ = true;
+  }
+
+  void topology_kernel::clear_vert_star()
+  {
+    is_vert_star_built_ = false;
+    std::vector<std::vector<size_t> >().swap(vert_star_offsets_);
+    std::vector<std::vector<simplex_handle> >().swap(vert_star_);
+  }
+
+  void topology_kernel::get_star_k_co_boundary(const simplex_handle& sh, size_t k,
+                                               std::vector<simplex_handle>& co_bounds) const
+  {
+    assert(is_vert_star_built_);
+    co_bounds.clear();
+    simplex_handle verts[MAX_SIMPLEX_DIM + 1];
+    const size_t vert_num = get_simplex_verts(sh, verts);
+
+    // scan the shortest star and search the others, the stars are sorted
+    const simplex_handle* stars[MAX_SIMPLEX_DIM + 1];
+    size_t sizes[MAX_SIMPLEX_DIM + 1];
+    size_t shortest = 0;
+    for(size_t i = 0; i < vert_num; ++i)
+      {
+        sizes[i] = get_vert_star(verts[i], k, stars[i]);
+        if(sizes[i] < sizes[shortest])
+          shortest = i;
+      }
+    for(size_t i = 0; i < sizes[shortest]; ++i)
+      {
+        const simplex_handle& cur_sh = stars[shortest][i];
+        if(is_simplex_deleted(cur_sh))
+          continue;
+        bool is_co_bound = true;
+        for(size_t j = 0; j < vert_num && is_co_bound; ++j)
+          if(j != shortest)
+            is_co_bound = std::binary_search(stars[j], stars[j] + sizes[j], cur_sh);
+        if(is_co_bound)
+          co_bounds.push_back(cur_sh);
+      }
+  }
+
+  void topology_kernel::get_star_adjacent_verts(const simplex_handle& sh,
+                                                std::vector<simplex_handle>& adjacent) const
+  {
+    assert(is_vert_star_built_ && sh.dim() == 0);
+    adjacent.clear();
+    const simplex_handle* edges;
+    const size_t edge_num = get_vert_star(sh, 1, edges);
+    for(size_t i = 0; i < edge_num; ++i)
+      {
+        if(is_simplex_deleted(edges[i]))
+          continue;
+        const simplex::boundary_type& bounds = sm_.get_specific_simplex(edges[i]).get_boundary();
+        adjacent.push_back(bounds[0] == sh ? bounds[1] : bounds[0]);
+      }
+  }
+
   int topology_kernel::new_vert(size_t id, const coord_type& coord, simplex_handle& sh)
   {
+    assert(gc_phase_ == GC_IDLE);
     const simplex_dim cur_dim = 0;
-    sm_.push_back(cur_dim, simplex());
-    pm_.resize(cur_dim, sm_.n_element(cur_dim));
     sh.set_dim(cur_dim);
-    sh.set_id(sm_.n_element(cur_dim) - 1);
+    const size_t slot = is_slot_reused_ ? get_free_slot(cur_dim) : size_t(-1);
+    if(slot == size_t(-1) && check_id_range(cur_dim, 1))
+      return __LINE__;
+    if(slot != size_t(-1))
+      {
+        free_slots_[cur_dim].pop_back();
+        sm_.get_specific_simplex(simplex_handle(cur_dim, slot)) = simplex();
+        pm_.reset(cur_dim, slot);
+        sh.set_id(slot);
+      }
+    else
+      {
+        sm_.push_back(cur_dim, simplex());
+        pm_.resize(cur_dim, sm_.n_element(cur_dim));
+        sh.set_id(sm_.n_element(cur_dim) - 1);
+      }
     set_coord(sh, coord);
     return 0;
   }
 
+  int topology_kernel::new_verts(const matrixd& node)
+  {
+    assert(node.size(1) == 3);
+    return new_verts(node.size() == 0 ? 0 : &node[0], node.size(2));
+  }
+
+  int topology_kernel::new_verts(const double* coords, size_t num)
+  {
+    assert(gc_phase_ == GC_IDLE);
+    const simplex_dim cur_dim = 0;
+    if(check_id_range(cur_dim, num))
+      return __LINE__;
+    const size_t old_num = sm_.n_element(cur_dim);
+    sm_.resize(cur_dim, old_num + num);
+    pm_.resize(cur_dim, old_num + num);
+    std::vector<vert_coord>& dst = coord_prop_->get_vector();
+    for(size_t i = 0; i < num; ++i)
+      std::copy(coords + 3 * i, coords + 3 * i + 3, dst[old_num + i].x);
+    return 0;
+  }
+
+
+  /// This function returns the number of the threads of the current parallel region
+  static size_t get_thread_num()
+  {
+#ifdef _OPENMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+  }
+
+  /// This function returns the index of the current thread in the current parallel region
+  static size_t get_thread_id()
+  {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+  }
+
+  /// an occurrence of a sub simplex used by group_sub_simplices, KEY is uint64_t or simplex_key
+  template <typename KEY>
+  struct sub_simplex_occ
+  {
+    KEY key;
+    uint32_t occ;
+  };
+
+  /// This function packs the k vertexes of key_bits bits into one integer, the first is the highest
+  static void make_sub_simplex_key(const size_t* verts, size_t k, size_t key_bits, uint64_t& key)
+  {
+    key = 0;
+    for(size_t j = 0; j < k; ++j)
+      key = (key << key_bits) | verts[j];
+  }
+
+  static void make_sub_simplex_key(const size_t* verts, size_t k, size_t, simplex_key& key)
+  {
+    key = simplex_key(verts, k);
+  }
+
+  /// This function returns the bits of the key from shift, the bits of the last vertex are the lowest
+  static uint32_t get_sub_simplex_digit(const uint64_t& key, size_t, size_t, size_t shift)
+  {
+    return key >> shift;
+  }
+
+  static uint32_t get_sub_simplex_digit(const simplex_key& key, size_t k, size_t key_bits, size_t shift)
+  {
+    return key[k - 1 - shift / key_bits] >> (shift % key_bits);
+  }
+
+  /** This function groups the sub simplexes of the cells which have the same vertexes by radix
+    * sorting their vertexes, see group_sub_simplices
+    * \param key_bits the number of bits of a vertex
+    */
+  template <typename KEY>
+  static size_t group_sub_simplices(const std::vector<size_t>& cells, size_t n,
+                                    const int* local, size_t local_num, size_t k, size_t key_bits,
+                                    std::vector<size_t>& occ2id, std::vector<size_t>& first_occ,
+                                    std::vector<size_t>* last_occ)
+  {
+    const size_t occ_num = cells.size() / n * local_num;
+    assert(occ_num < uint32_t(-1));
+    std::vector<sub_simplex_occ<KEY> > occs(occ_num), tmp(occ_num);
+#pragma omp parallel for
+    for(size_t o = 0; o < occ_num; ++o)
+      {
+        size_t verts[simplex_key::MAX_VERT_NUM];
+        for(size_t j = 0; j < k; ++j)
+          verts[j] = cells[o / local_num * n + local[o % local_num * k + j]];
+        make_sub_simplex_key(verts, k, key_bits, occs[o].key);
+        occs[o].occ = o;
+      }
+
+    // LSD radix sort, it is stable so the occurrences of a group keep ascending, the digits are
+    // small enough to keep the counters in cache. The last digit of a vertex in a packed key may
+    // also take the low bits of the next vertex, which is harmless since the passes of that vertex
+    // sort them again. Each thread counts and scatters a contiguous range, and the ranges are
+    // scattered in order, so the result does not depend on the number of the threads.
+    const size_t pass_num = (key_bits + 10) / 11;
+    const size_t digit_bits = (key_bits + pass_num - 1) / pass_num;
+    const size_t digit_num = size_t(1) << digit_bits;
+    const uint32_t digit_mask = digit_num - 1;
+    std::vector<size_t> cnt;
+    for(size_t j = 0; j < k; ++j)
+      for(size_t shift = j * key_bits; shift < (j + 1) * key_bits; shift += digit_bits)
+        {
+#pragma omp parallel
+          {
+            const size_t thread_num = get_thread_num(), t = get_thread_id();
+            const size_t begin = occ_num * t / thread_num, end = occ_num * (t + 1) / thread_num;
+#pragma omp single
+            cnt.assign(digit_num * thread_num, 0);
+            size_t* thread_cnt = &cnt[digit_num * t];
+            for(size_t i = begin; i < end; ++i)
+              ++thread_cnt[get_sub_simplex_digit(occs[i].key, k, key_bits, shift) & digit_mask];
+#pragma omp barrier
+#pragma omp single
+            {
+              size_t sum = 0;
+              for(size_t d = 0; d < digit_num; ++d)
+                for(size_t s = 0; s < thread_num; ++s)
+                  {
+                    const size_t c = cnt[digit_num * s + d];
+                    cnt[digit_num * s + d] = sum;
+                    sum += c;
+                  }
+            }
+            for(size_t i = begin; i < end; ++i)
+              tmp[thread_cnt[get_sub_simplex_digit(occs[i].key, k, key_bits, shift) & digit_mask]++] = occs[i];
+          }
+          occs.swap(tmp);
+        }
+
+    // map each occurrence to the first occurrence of its group
+    size_t max_occ = 0;
+    occ2id.resize(occ_num);
+#pragma omp parallel for reduction(max:max_occ)
+    for(size_t i = 0; i < occ_num; ++i)
+      {
+        size_t begin = i;
+        while(begin > 0 && occs[begin - 1].key == occs[i].key)
+          --begin;
+        occ2id[occs[i].occ] = occs[begin].occ;
+        max_occ = std::max(max_occ, i - begin + 1);
+      }
+
+    // number the groups in the order of their first occurrences
+    std::vector<size_t> first2id(occ_num), thread_first;
+#pragma omp parallel
+    {
+      const size_t thread_num = get_thread_num(), t = get_thread_id();
+      const size_t begin = occ_num * t / thread_num, end = occ_num * (t + 1) / thread_num;
+#pragma omp single
+      thread_first.assign(thread_num + 1, 0);
+      size_t first_num = 0;
+      for(size_t o = begin; o < end; ++o)
+        if(occ2id[o] == o)
+          ++first_num;
+      thread_first[t + 1] = first_num;
+#pragma omp barrier
+#pragma omp single
+      {
+        for(size_t s = 0; s < thread_num; ++s)
+          thread_first[s + 1] += thread_first[s];
+        first_occ.resize(thread_first[thread_num]);
+      }
+      size_t id = thread_first[t];
+      for(size_t o = begin; o < end; ++o)
+        if(occ2id[o] == o)
+          {
+            first2id[o] = id;
+            first_occ[id++] = o;
+          }
+#pragma omp barrier
+      for(size_t o = begin; o < end; ++o)
+        occ2id[o] = first2id[occ2id[o]];
+    }
+
+    if(last_occ != 0)
+      {
+        last_occ->resize(first_occ.size());
+#pragma omp parallel for
+        for(size_t i = 0; i < occ_num; ++i)
+          if(i + 1 == occ_num || occs[i + 1].key != occs[i].key)
+            (*last_occ)[occ2id[occs[i].occ]] = occs[i].occ;
+      }
+    return max_occ;
+  }
+
+  /** This function groups the sub simplexes of the cells which have the same vertexes by radix
+    * sorting their vertexes, the groups are numbered in the order of their first occurrences, so
+    * the numbers are the same as the identifiers given by new_simplex when the cells are added one
+    * by one. The occurrence o is the (o % local_num)'th sub simplex of the (o / local_num)'th cell.
+    * The vertexes are packed into one 64-bit integer if they fit.
+    * \param cells the sorted vertexes of the cells, n per cell
+    * \param n the number of the vertexes of a cell
+    * \param local the positions of the vertexes of the sub simplexes in a cell, k per sub simplex
+    * \param local_num the number of the sub simplexes of a cell
+    * \param k the number of the vertexes of a sub simplex
+    * \param vert_num the number of the vertexes of the mesh
+    * \param occ2id the group number of each occurrence
+    * \param first_occ the first occurrence of each group
+    * \param last_occ the last occurrence of each group, it is not computed if it is null
+    * \return the maximum number of the occurrences of a group
+    */
+  static size_t group_sub_simplices(const std::vector<size_t>& cells, size_t n,
+                                    const int* local, size_t local_num, size_t k, size_t vert_num,
+                                    std::vector<size_t>& occ2id, std::vector<size_t>& first_occ,
+                                    std::vector<size_t>* last_occ = 0)
+  {
+    size_t key_bits = 1;
+    while((size_t(1) << key_bits) < vert_num)
+      ++key_bits;
+    if(key_bits * k <= 64)
+      return group_sub_simplices<uint64_t>(cells, n, local, local_num, k, key_bits,
+                                           occ2id, first_occ, last_occ);
+    return group_sub_simplices<simplex_key>(cells, n, local, local_num, k, key_bits,
+                                            occ2id, first_occ, last_occ);
+  }
+
+  /** This function returns the key of an occurrence of a sub simplex, see group_sub_simplices
+    * \param cells the sorted vertexes of the cells, n per cell
+    * \param n the number of the vertexes of a cell
+    * \param local the positions of the vertexes of the sub simplexes in a cell, k per sub simplex
+    * \param local_num the number of the sub simplexes of a cell
+    * \param k the number of the vertexes of a sub simplex
+    * \param o the occurrence
+    * \return the key of the occurrence
+    */
+  static simplex_key get_sub_simplex_key(const std::vector<size_t>& cells, size_t n,
+                                         const int* local, size_t local_num, size_t k, size_t o)
+  {
+    size_t verts[simplex_key::MAX_VERT_NUM];
+    for(size_t j = 0; j < k; ++j)
+      verts[j] = cells[o / local_num * n + local[o % local_num * k + j]];
+    return simplex_key(verts, k);
+  }
+
+  int topology_kernel::new_top_simplices(const matrixst& cells)
+  {
+    assert(cells.size(1) == top_dim_ + 1);
+    std::vector<size_t> verts(cells.begin(), cells.end());
+    return new_top_simplices(verts);
+  }
+
+  int topology_kernel::new_top_simplices(std::vector<size_t>& cells)
+  {
+    assert(gc_phase_ == GC_IDLE);
+    assert(cells.size() % (top_dim_ + 1) == 0);
+    clear_vert_star();
+    const size_t n = top_dim_ + 1;
+    const size_t cell_num = cells.size() / n;
+    const size_t vert_num = sm_.n_element(0);
+    bool is_empty = true;
+    for(size_t i = 1; i <= top_dim_; ++i)
+      if(sm_.n_element(i) != 0)
+        is_empty = false;
+    if(!is_empty || (top_dim_ != 2 && top_dim_ != 3))
+      {
+        std::vector<size_t> verts(n);
+        simplex_handle sh;
+        for(size_t i = 0; i < cell_num; ++i)
+          {
+            std::copy(&cells[n * i], &cells[n * i] + n, verts.begin());
+            if(new_top_simplex(verts, sh))
+              return __LINE__;
+          }
+        return 0;
+      }
+
+    if(check_id_range(top_dim_, cell_num))
+      return __LINE__;
+
+    // the vertexes of each cell are sorted in place
+    std::vector<size_t>& sorted = cells;
+    size_t bad_cell = cell_num;
+#pragma omp parallel for reduction(min:bad_cell)
+    for(size_t i = 0; i < cell_num; ++i)
+      {
+        std::sort(sorted.begin() + n * i, sorted.begin() + n * (i + 1));
+        if(sorted[n * (i + 1) - 1] >= vert_num ||
+           std::adjacent_find(sorted.begin() + n * i, sorted.begin() + n * (i + 1)) !=
+           sorted.begin() + n * (i + 1))
+          bad_cell = std::min(bad_cell, i);
+      }
+    if(bad_cell != cell_num)
+      {
+        if(sorted[n * (bad_cell + 1) - 1] >= vert_num)
+          std::cerr << "# [error] top simplex index beyond vertex size" << std::endl;
+        else
+          std::cerr << "# [error] degenerated top simplex " << bad_cell << std::endl;
+        return __LINE__;
+      }
+
+    // the sub simplexes of a cell in the same order as new_tet and new_tri
+    const int tet_face_local[] = {0, 1, 2,  0, 1, 3,  0, 2, 3,  1, 2, 3};
+    const int tet_edge_local[] = {0, 1,  0, 2,  0, 3,  1, 2,  1, 3,  2, 3};
+    const int tri_edge_local[] = {0, 1,  0, 2,  1, 2};
+    const int face2edge[] = {0, 1, 3,  0, 2, 4,  1, 2, 5,  3, 4, 5};
+    const int edge2face[] = {0, 2, 1, 3, 3, 3};
+    const int tet_vert2edge[] = {0, 3, 5, 2};
+    const int tri_vert2edge[] = {0, 2, 1};
+
+    const simplex_dim facet_dim = top_dim_ - 1;
+    const int* facet_local = (top_dim_ == 3 ? tet_face_local : tri_edge_local);
+    const int* edge_local = (top_dim_ == 3 ? tet_edge_local : tri_edge_local);
+    const size_t edge_num = (top_dim_ == 3 ? 6 : 3);
+    const int* vert2edge = (top_dim_ == 3 ? tet_vert2edge : tri_vert2edge);
+
+    std::vector<size_t> facet_ids, facet_first, tet_edge_ids, tet_edge_first, tet_edge_last;
+    if(group_sub_simplices(sorted, n, facet_local, n, n - 1, vert_num, facet_ids, facet_first) > 2)
+      {
+        std::cerr << "# [error] non-manifold top simplex" << std::endl;
+        return __LINE__;
+      }
+    if(top_dim_ == 3)
+      group_sub_simplices(sorted, n, edge_local, edge_num, 2, vert_num,
+                          tet_edge_ids, tet_edge_first, &tet_edge_last);
+    // the edges are the facets of a triangle mesh
+    const std::vector<size_t>& edge_ids = (top_dim_ == 3 ? tet_edge_ids : facet_ids);
+    const std::vector<size_t>& edge_first = (top_dim_ == 3 ? tet_edge_first : facet_first);
+    if(check_id_range(facet_dim, facet_first.size()) || check_id_range(1, edge_first.size()))
+      return __LINE__;
+
+    // the hash tables of different dimensions are filled at the same time
+    size_t dup_cell = cell_num;
+#pragma omp parallel sections
+    {
+#pragma omp section
+      {
+        simplex_handle exist;
+        simplex_hash_table& table = simplex2handle_[top_dim_];
+        table.reserve(cell_num);
+        for(size_t i = 0; i < cell_num; ++i)
+          if(!table.insert(simplex_key(&sorted[n * i], n), simplex_handle(top_dim_, i), exist))
+            {
+              dup_cell = i;
+              break;
+            }
+      }
+#pragma omp section
+      {
+        simplex_handle exist;
+        simplex_hash_table& table = simplex2handle_[facet_dim];
+        table.reserve(facet_first.size());
+        for(size_t i = 0; i < facet_first.size(); ++i)
+          table.insert(get_sub_simplex_key(sorted, n, facet_local, n, n - 1, facet_first[i]),
+                       simplex_handle(facet_dim, i), exist);
+      }
+#pragma omp section
+      {
+        if(top_dim_ == 3)
+          {
+            simplex_handle exist;
+            simplex_hash_table& table = simplex2handle_[1];
+            table.reserve(edge_first.size());
+            for(size_t i = 0; i < edge_first.size(); ++i)
+              table.insert(get_sub_simplex_key(sorted, n, edge_local, edge_num, 2, edge_first[i]),
+                           simplex_handle(1, i), exist);
+          }
+      }
+    }
+    if(dup_cell != cell_num)
+      {
+        for(size_t i = 1; i <= top_dim_; ++i)
+          simplex2handle_[i].clear();
+        std::cerr << "# [error] duplicated top simplex " << dup_cell << std::endl;
+        return __LINE__;
+      }
+
+    sm_.resize(top_dim_, cell_num);
+    pm_.resize(top_dim_, cell_num);
+    sm_.resize(facet_dim, facet_first.size());
+    pm_.resize(facet_dim, facet_first.size());
+    sm_.resize(1, edge_first.size());
+    pm_.resize(1, edge_first.size());
+
+    // the boundary of the top simplexes
+#pragma omp parallel for
+    for(size_t i = 0; i < cell_num; ++i)
+      {
+        simplex::boundary_type& bounds = sm_.get_specific_simplex(simplex_handle(top_dim_, i)).get_boundary();
+        bounds.resize(n);
+        for(size_t j = 0; j < n; ++j)
+          bounds[j] = simplex_handle(facet_dim, facet_ids[n * i + j]);
+      }
+
+    // the partial co_boundary of the facets, the cell of the first occurrence is the first
+#pragma omp parallel for
+    for(size_t i = 0; i < facet_first.size(); ++i)
+      {
+        simplex::par_co_boundary_type& co_bound =
+            sm_.get_specific_simplex(simplex_handle(facet_dim, i)).get_par_co_boundary();
+        co_bound.resize(1);
+        co_bound[0] = simplex_handle(top_dim_, facet_first[i] / n);
+      }
+#pragma omp parallel for
+    for(size_t o = 0; o < facet_ids.size(); ++o)
+      if(facet_first[facet_ids[o]] != o)
+        sm_.get_specific_simplex(simplex_handle(facet_dim, facet_ids[o]))
+            .get_par_co_boundary().push_back(simplex_handle(top_dim_, o / n));
+
+    // the boundary of the faces and the partial co_boundary of the edges of the tets, the face of
+    // the last occurrence wins as in new_tet
+    if(top_dim_ == 3)
+      {
+#pragma omp parallel for
+        for(size_t i = 0; i < facet_first.size(); ++i)
+          {
+            const size_t cell = facet_first[i] / n, face = facet_first[i] % n;
+            simplex::boundary_type& bounds = sm_.get_specific_simplex(simplex_handle(2, i)).get_boundary();
+            bounds.resize(3);
+            for(size_t j = 0; j < 3; ++j)
+              bounds[j] = simplex_handle(1, edge_ids[edge_num * cell + face2edge[3 * face + j]]);
+          }
+#pragma omp parallel for
+        for(size_t i = 0; i < tet_edge_last.size(); ++i)
+          {
+            const size_t o = tet_edge_last[i];
+            simplex::par_co_boundary_type& co_bound =
+                sm_.get_specific_simplex(simplex_handle(1, i)).get_par_co_boundary();
+            co_bound.resize(1);
+            co_bound[0] = simplex_handle(2, facet_ids[n * (o / edge_num) + edge2face[o % edge_num]]);
+          }
+      }
+
+    // the boundary of the edges
+#pragma omp parallel for
+    for(size_t i = 0; i < edge_first.size(); ++i)
+      {
+        simplex::boundary_type& bounds = sm_.get_specific_simplex(simplex_handle(1, i)).get_boundary();
+        const size_t o = edge_first[i];
+        bounds.resize(2);
+        for(size_t j = 0; j < 2; ++j)
+          bounds[j] = simplex_handle(0, sorted[n * (o / edge_num) + edge_local[o % edge_num * 2 + j]]);
+      }
+
+    // the partial co_boundary of the vertexes, the last cell wins as in new_tet and new_tri. Each
+    // thread buckets the occurrences of its cells by the vertex range of each thread, then each
+    // thread visits the buckets of its vertex range in the order of the cells
+    std::vector<std::vector<uint32_t> > vert_occs;
+#pragma omp parallel
+    {
+      const size_t thread_num = get_thread_num(), t = get_thread_id();
+      const size_t begin = cell_num * t / thread_num * n, end = cell_num * (t + 1) / thread_num * n;
+#pragma omp single
+      vert_occs.resize(thread_num * thread_num);
+      for(size_t i = begin; i < end; ++i)
+        vert_occs[thread_num * t + sorted[i] * thread_num / vert_num].push_back(i);
+#pragma omp barrier
+      for(size_t s = 0; s < thread_num; ++s)
+        {
+          const std::vector<uint32_t>& occs = vert_occs[thread_num * s + t];
+          for(size_t j = 0; j < occs.size(); ++j)
+            {
+              const size_t i = occs[j];
+              simplex::par_co_boundary_type& co_bound =
+                  sm_.get_specific_simplex(simplex_handle(0, sorted[i])).get_par_co_boundary();
+              co_bound.resize(1);
+              co_bound[0] = simplex_handle(1, edge_ids[edge_num * (i / n) + vert2edge[i % n]]);
+            }
+        }
+    }
+
+    if(is_top_verts_cached_)
+      top_verts_.swap(sorted);
+    return 0;
+  }
 
   void topology_kernel::get_all_boundary_simplex(const simplex_handle& sh,
-                                                 std::vector<simplex_handle>& bounds)
+                                                 std::vector<simplex_handle>& bounds,
+                                                 query_context& ctx) const
   {
+    assert(gc_phase_ == GC_IDLE);
     assert(is_valid_handle(sh));
     assert(!is_simplex_deleted(sh));
     bounds.clear();
     if(sh.dim() == 0)
       return;
-    std::queue<simplex_handle> q;
-    const std::vector<simplex_handle>& simplex_bound = sm_.get_specific_simplex(sh).get_boundary();
+    handle_queue& q = ctx.bound_queue_;
+    q.clear();
+    handle_set& visited_simplex = ctx.bound_visited_;
+    visited_simplex.clear();
+    const simplex::boundary_type& simplex_bound = sm_.get_specific_simplex(sh).get_boundary();
     for(size_t i = 0; i < simplex_bound.size(); ++i)
       {
         q.push(simplex_bound[i]);
@@ -104,76 +971,91 @@ namespace is_mesh
       {
         simplex_handle cur_sh = q.front();
         q.pop();
-        if(!is_simplex_bound_visited(cur_sh))
+        if(visited_simplex.insert(cur_sh))
           {
             bounds.push_back(cur_sh);
-            set_simplex_bound_visited(cur_sh);
             if(cur_sh.dim() > 0)
               {
-                const std::vector<simplex_handle>& cur_simplex_bound =
+                const simplex::boundary_type& cur_simplex_bound =
                     sm_.get_specific_simplex(cur_sh).get_boundary();
                 for(size_t i = 0; i < cur_simplex_bound.size(); ++i)
-                  if(!is_simplex_bound_visited(cur_simplex_bound[i]))
+                  if(!visited_simplex.contains(cur_simplex_bound[i]))
                     q.push(cur_simplex_bound[i]);
               }
           }
       }
-    for(size_t i = 0; i < bounds.size(); ++i)
-      reset_simplex_bound_visited(bounds[i]);
   }
 
   void topology_kernel::get_k_boundary_simplex(const simplex_handle& sh, size_t k,
-                                               std::vector<simplex_handle>& bounds)
+                                               std::vector<simplex_handle>& bounds,
+                                               query_context& ctx) const
   {
+    assert(gc_phase_ == GC_IDLE);
     assert(is_valid_handle(sh));
     assert(!is_simplex_deleted(sh));
     assert(sh.dim() > k && k >= 0);
     bounds.clear();
     if(sh.dim() == 0)
       return;
-    std::queue<simplex_handle> q;
-    std::vector<simplex_handle> visited_simplex;
-    const std::vector<simplex_handle>& simplex_bound = sm_.get_specific_simplex(sh).get_boundary();
+    if(k == 0)
+      {
+        bounds.resize(sh.dim() + 1);
+        get_simplex_verts(sh, &bounds[0]);
+        return;
+      }
+    handle_queue& q = ctx.bound_queue_;
+    q.clear();
+    handle_set& visited_simplex = ctx.bound_visited_;
+    visited_simplex.clear();
+    const simplex::boundary_type& simplex_bound = sm_.get_specific_simplex(sh).get_boundary();
     for(size_t i = 0; i < simplex_bound.size(); ++i)
       q.push(simplex_bound[i]);
     while(!q.empty())
       {
         simplex_handle cur_sh = q.front();
         q.pop();
-        if(!is_simplex_bound_visited(cur_sh))
+        if(visited_simplex.insert(cur_sh))
           {
-            set_simplex_bound_visited(cur_sh);
-            visited_simplex.push_back(cur_sh);
             if(cur_sh.dim() == k)
               bounds.push_back(cur_sh);
             else if(cur_sh.dim() > k)
               {
-                const std::vector<simplex_handle>& cur_simplex_bound =
+                const simplex::boundary_type& cur_simplex_bound =
                     sm_.get_specific_simplex(cur_sh).get_boundary();
                 for(size_t i = 0; i < cur_simplex_bound.size(); ++i)
-                  if(!is_simplex_bound_visited(cur_simplex_bound[i]))
+                  if(!visited_simplex.contains(cur_simplex_bound[i]))
                     q.push(cur_simplex_bound[i]);
               }
           }
       }
-    for(size_t i = 0; i < visited_simplex.size(); ++i)
-      reset_simplex_bound_visited(visited_simplex[i]);
   }
 
   void topology_kernel::get_all_co_boundary_simplex(const simplex_handle& sh,
-                                                    std::vector<simplex_handle>& co_bounds)
+                                                    std::vector<simplex_handle>& co_bounds,
+                                                    query_context& ctx) const
   {
+    assert(gc_phase_ == GC_IDLE);
     assert(is_valid_handle(sh));
     assert(!is_simplex_deleted(sh));
     co_bounds.clear();
     if(sh.dim() == top_dim_)
       return;
-    std::queue<simplex_handle> q;
-    std::vector<simplex_handle> visited_simplex;
+    if(is_vert_star_built_)
+      {
+        std::vector<simplex_handle>& k_co_bounds = ctx.star_co_bounds_;
+        for(size_t k = sh.dim() + 1; k <= top_dim_; ++k)
+          {
+            get_star_k_co_boundary(sh, k, k_co_bounds);
+            co_bounds.insert(co_bounds.end(), k_co_bounds.begin(), k_co_bounds.end());
+          }
+        return;
+      }
+    handle_queue& q = ctx.co_bound_queue_;
+    q.clear();
+    handle_set& visited_simplex = ctx.co_bound_visited_;
+    visited_simplex.clear();
     q.push(sh);
-    assert(!is_simplex_co_bound_visited(sh));
-    set_simplex_co_bound_visited(sh);
-    visited_simplex.push_back(sh);
+    visited_simplex.insert(sh);
     while(!q.empty())
       {
         simplex_handle cur_sh = q.front();
@@ -182,50 +1064,51 @@ namespace is_mesh
           {
             co_bounds.push_back(cur_sh);
           }
-        const std::vector<simplex_handle>& cur_par_co_bound =
+        const simplex::par_co_boundary_type& cur_par_co_bound =
             sm_.get_specific_simplex(cur_sh).get_par_co_boundary();
         for(size_t i = 0; i < cur_par_co_bound.size(); ++i)
           {
-            if(!is_simplex_co_bound_visited(cur_par_co_bound[i]))
-              {
-                q.push(cur_par_co_bound[i]);
-                set_simplex_co_bound_visited(cur_par_co_bound[i]);
-                visited_simplex.push_back(cur_par_co_bound[i]);
-              }
+            if(visited_simplex.insert(cur_par_co_bound[i]))
+              q.push(cur_par_co_bound[i]);
           }
+        push_extra_co_bounds(cur_sh, visited_simplex, q);
         if(cur_sh.dim() > sh.dim() + 1)
           {
-            const std::vector<simplex_handle>& cur_simplex_bound =
+            const simplex::boundary_type& cur_simplex_bound =
                 sm_.get_specific_simplex(cur_sh).get_boundary();
             for(size_t i = 0; i < cur_simplex_bound.size(); ++i)
               {
-                if(!is_simplex_co_bound_visited(cur_simplex_bound[i]) &&
+                if(!visited_simplex.contains(cur_simplex_bound[i]) &&
                    is_belong(sh, cur_simplex_bound[i]))
                   {
                     q.push(cur_simplex_bound[i]);
-                    set_simplex_co_bound_visited(cur_simplex_bound[i]);
-                    visited_simplex.push_back(cur_simplex_bound[i]);
+                    visited_simplex.insert(cur_simplex_bound[i]);
                   }
               }
           }
       }
-    for(size_t i = 0; i < visited_simplex.size(); ++i)
-      reset_simplex_co_bound_visited(visited_simplex[i]);
   }
 
   void topology_kernel::get_k_co_boundary_simplex(const simplex_handle& sh, size_t k,
-                                                  std::vector<simplex_handle>& co_bounds)
+                                                  std::vector<simplex_handle>& co_bounds,
+                                                  query_context& ctx) const
   {
+    assert(gc_phase_ == GC_IDLE);
     assert(is_valid_handle(sh));
     assert(!is_simplex_deleted(sh));
     assert(sh.dim() < k);
     co_bounds.clear();
-    std::queue<simplex_handle> q;
-    std::vector<simplex_handle> visited_simplex;
+    if(is_vert_star_built_)
+      {
+        get_star_k_co_boundary(sh, k, co_bounds);
+        return;
+      }
+    handle_queue& q = ctx.co_bound_queue_;
+    q.clear();
+    handle_set& visited_simplex = ctx.co_bound_visited_;
+    visited_simplex.clear();
     q.push(sh);
-    assert(!is_simplex_co_bound_visited(sh));
-    set_simplex_co_bound_visited(sh);
-    visited_simplex.push_back(sh);
+    visited_simplex.insert(sh);
     while(!q.empty())
       {
         simplex_handle cur_sh = q.front();
@@ -235,40 +1118,36 @@ namespace is_mesh
             if(cur_sh.dim() == k)
               co_bounds.push_back(cur_sh);
           }
-        const std::vector<simplex_handle>& cur_par_co_bound =
+        const simplex::par_co_boundary_type& cur_par_co_bound =
             sm_.get_specific_simplex(cur_sh).get_par_co_boundary();
         for(size_t i = 0; i < cur_par_co_bound.size(); ++i)
           {
-            if(!is_simplex_co_bound_visited(cur_par_co_bound[i]))
-              {
-                q.push(cur_par_co_bound[i]);
-                set_simplex_co_bound_visited(cur_par_co_bound[i]);
-                visited_simplex.push_back(cur_par_co_bound[i]);
-              }
+            if(visited_simplex.insert(cur_par_co_bound[i]))
+              q.push(cur_par_co_bound[i]);
           }
+        push_extra_co_bounds(cur_sh, visited_simplex, q);
         if(cur_sh.dim() > sh.dim() + 1)
           {
-            const std::vector<simplex_handle>& cur_simplex_bound =
+            const simplex::boundary_type& cur_simplex_bound =
                 sm_.get_specific_simplex(cur_sh).get_boundary();
             for(size_t i = 0; i < cur_simplex_bound.size(); ++i)
               {
-                if(!is_simplex_co_bound_visited(cur_simplex_bound[i]) &&
+                if(!visited_simplex.contains(cur_simplex_bound[i]) &&
                    is_belong(sh, cur_simplex_bound[i]))
                   {
                     q.push(cur_simplex_bound[i]);
-                    set_simplex_co_bound_visited(cur_simplex_bound[i]);
-                    visited_simplex.push_back(cur_simplex_bound[i]);
+                    visited_simplex.insert(cur_simplex_bound[i]);
                   }
               }
           }
       }
-    for(size_t i = 0; i < visited_simplex.size(); ++i)
-      reset_simplex_co_bound_visited(visited_simplex[i]);
   }
 
   void topology_kernel::get_adjacent_simplex(const simplex_handle& sh,
-                                             std::vector<simplex_handle>& adjacent)
+                                             std::vector<simplex_handle>& adjacent,
+                                             query_context& ctx) const
   {
+    assert(gc_phase_ == GC_IDLE);
 
     if(!is_valid_handle(sh))
       {
@@ -278,8 +1157,15 @@ namespace is_mesh
     assert(!is_simplex_deleted(sh));
     adjacent.clear();
     bool is_vertex = (sh.dim() == 0);
-    std::queue<simplex_handle> q;
-    std::vector<simplex_handle> visited_simplex;
+    if(is_vertex && is_vert_star_built_)
+      {
+        get_star_adjacent_verts(sh, adjacent);
+        return;
+      }
+    handle_queue& q = ctx.adj_queue_;
+    q.clear();
+    handle_set& visited_simplex = ctx.adj_visited_;
+    visited_simplex.clear();
     #if 0
     if(is_vertex)
       {
@@ -287,22 +1173,18 @@ namespace is_mesh
         get_k_co_boundary_simplex(sh, 1, co_bounds);
         for(size_t i = 0; i < co_bounds.size(); ++i)
           {
-            const std::vector<simplex_handle>& bounds =
+            const simplex::boundary_type& bounds =
                 sm_.get_specific_simplex(co_bounds[i]).get_boundary();
             for(size_t j = 0; j < bounds.size(); ++j)
               {
-                if(bounds[j] != sh && !is_simplex_adjacent_visited(bounds[j]))
-                  {
-                    adjacent.push_back(bounds[j]);
-                    set_simplex_adjacent_visited(bounds[j]);
-                    visited_simplex.push_back(bounds[j]);
-                  }
+                if(bounds[j] != sh && visited_simplex.insert(bounds[j]))
+                  adjacent.push_back(bounds[j]);
               }
           }
       }
     else
       {
-        const std::vector<simplex_handle>& simplex_bounds =
+        const simplex::boundary_type& simplex_bounds =
             sm_.get_specific_simplex(sh).get_boundary();
         std::vector<simplex_handle> co_bounds;
         for(size_t i = 0; i < simplex_bounds.size(); ++i)
@@ -310,12 +1192,8 @@ namespace is_mesh
             get_k_co_boundary_simplex(simplex_bounds[i], sh.dim(), co_bounds);
             for(size_t j = 0; j < co_bounds.size(); ++j)
               {
-                if(co_bounds[j] != sh && !is_simplex_adjacent_visited(co_bounds[j]))
-                  {
-                    adjacent.push_back(co_bounds[j]);
-                    set_simplex_adjacent_visited(co_bounds[j]);
-                    visited_simplex.push_back(co_bounds[j]);
-                  }
+                if(co_bounds[j] != sh && visited_simplex.insert(co_bounds[j]))
+                  adjacent.push_back(co_bounds[j]);
               }
           }
       }
@@ -323,18 +1201,14 @@ namespace is_mesh
     if(is_vertex)
       {
         q.push(sh);
-        assert(!is_simplex_adjacent_visited(sh));
-        set_simplex_adjacent_visited(sh);
-        visited_simplex.push_back(sh);
+        visited_simplex.insert(sh);
       }
-    const std::vector<simplex_handle>& simplex_bounds =
+    const simplex::boundary_type& simplex_bounds =
         sm_.get_specific_simplex(sh).get_boundary();
     for(size_t i = 0; i < simplex_bounds.size(); ++i)
       {
         q.push(simplex_bounds[i]);
-        assert(!is_simplex_adjacent_visited(simplex_bounds[i]));
-        set_simplex_adjacent_visited(simplex_bounds[i]);
-        visited_simplex.push_back(simplex_bounds[i]);
+        visited_simplex.insert(simplex_bounds[i]);
       }
     while(!q.empty())
       {
@@ -344,24 +1218,21 @@ namespace is_mesh
           {
             adjacent.push_back(cur_sh);
           }
-        const std::vector<simplex_handle>& cur_par_co_bound =
+        const simplex::par_co_boundary_type& cur_par_co_bound =
             sm_.get_specific_simplex(cur_sh).get_par_co_boundary();
         for(size_t i = 0; i < cur_par_co_bound.size(); ++i)
           {
-            if(!is_simplex_adjacent_visited(cur_par_co_bound[i]))
-              {
-                q.push(cur_par_co_bound[i]);
-                set_simplex_adjacent_visited(cur_par_co_bound[i]);
-                visited_simplex.push_back(cur_par_co_bound[i]);
-              }
+            if(visited_simplex.insert(cur_par_co_bound[i]))
+              q.push(cur_par_co_bound[i]);
           }
+        push_extra_co_bounds(cur_sh, visited_simplex, q);
         if(cur_sh.dim() > sh.dim())
           {
-            const std::vector<simplex_handle>& cur_simplex_bound =
+            const simplex::boundary_type& cur_simplex_bound =
                 sm_.get_specific_simplex(cur_sh).get_boundary();
             for(size_t i = 0; i < cur_simplex_bound.size(); ++i)
               {
-                bool vis_flg = is_simplex_adjacent_visited(cur_simplex_bound[i]);
+                bool vis_flg = visited_simplex.contains(cur_simplex_bound[i]);
                 if(vis_flg)
                   continue;
                 bool push_flg;
@@ -380,130 +1251,785 @@ namespace is_mesh
                 if(push_flg)
                   {
                     q.push(cur_simplex_bound[i]);
-                    set_simplex_adjacent_visited(cur_simplex_bound[i]);
-                    visited_simplex.push_back(cur_simplex_bound[i]);
+                    visited_simplex.insert(cur_simplex_bound[i]);
                   }
               }
           }
       }
     #endif
-    for(size_t i = 0; i < visited_simplex.size(); ++i)
-      reset_simplex_adjacent_visited(visited_simplex[i]);
   }
 
 
+  void topology_kernel::get_k_boundary_relation(size_t d, size_t k, std::vector<size_t>& offsets,
+                                                std::vector<simplex_handle>& bounds) const
+  {
+    assert(gc_phase_ == GC_IDLE);
+    assert(k < d && d <= top_dim_);
+    const size_t n = sm_.n_element(d);
+    // C(d + 1, k + 1) k-simplexes, d <= 3
+    const size_t row_size = (k == 0 || k + 1 == d) ? d + 1 : 6;
+    offsets.resize(n + 1);
+    offsets[0] = 0;
+    for(size_t i = 0; i < n; ++i)
+      offsets[i + 1] = offsets[i] + (is_simplex_deleted(simplex_handle(d, i)) ? 0 : row_size);
+    bounds.resize(offsets[n]);
+
+    // the boundary of a simplex is stored in the lexicographic order of the vertexes, so the facets
+    // are copied directly, and the edges of a tet are picked from the boundary of its faces
+#pragma omp parallel for
+    for(size_t i = 0; i < n; ++i)
+      {
+        if(offsets[i] == offsets[i + 1])
+          continue;
+        const simplex_handle sh(d, i);
+        simplex_handle* row = &bounds[offsets[i]];
+        if(k == 0)
+          get_simplex_verts(sh, row);
+        else
+          {
+            const simplex::boundary_type& facets = sm_.get_specific_simplex(sh).get_boundary();
+            if(k + 1 == d)
+              std::copy(facets.begin(), facets.end(), row);
+            else
+              {
+                assert(d == 3 && k == 1);
+                const simplex::boundary_type& abc = sm_.get_specific_simplex(facets[0]).get_boundary();
+                const simplex::boundary_type& abd = sm_.get_specific_simplex(facets[1]).get_boundary();
+                row[0] = abc[0];
+                row[1] = abc[1];
+                row[2] = abd[1];
+                row[3] = abc[2];
+                row[4] = abd[2];
+                row[5] = sm_.get_specific_simplex(facets[2]).get_boundary()[2];
+              }
+          }
+      }
+  }
+
+  void topology_kernel::get_k_co_boundary_relation(size_t d, size_t k, std::vector<size_t>& offsets,
+                                                   std::vector<simplex_handle>& co_bounds) const
+  {
+    assert(gc_phase_ == GC_IDLE);
+    assert(d < k && k <= top_dim_);
+    std::vector<size_t> high_offsets;
+    std::vector<simplex_handle> high_bounds;
+    get_k_boundary_relation(k, d, high_offsets, high_bounds);
+
+    // transpose the k-simplex to d-simplex relation by a counting sort, each thread counts and
+    // scatters a contiguous range of k-simplexes and the ranges are scattered in order, so every
+    // row is in the ascending order of the identifiers whatever the number of the threads is
+    const size_t n = sm_.n_element(d), high_num = sm_.n_element(k);
+    std::vector<size_t> cnt;
+    offsets.resize(n + 1);
+    co_bounds.resize(high_bounds.size());
+#pragma omp parallel
+    {
+      const size_t thread_num = get_thread_num(), t = get_thread_id();
+      const size_t begin = high_num * t / thread_num, end = high_num * (t + 1) / thread_num;
+#pragma omp single
+      cnt.assign(n * thread_num, 0);
+      size_t* thread_cnt = &cnt[n * t];
+      for(size_t i = high_offsets[begin]; i < high_offsets[end]; ++i)
+        ++thread_cnt[high_bounds[i].id()];
+#pragma omp barrier
+#pragma omp single
+      {
+        size_t sum = 0;
+        for(size_t r = 0; r < n; ++r)
+          {
+            offsets[r] = sum;
+            for(size_t s = 0; s < thread_num; ++s)
+              {
+                const size_t c = cnt[n * s + r];
+                cnt[n * s + r] = sum;
+                sum += c;
+              }
+          }
+        offsets[n] = sum;
+      }
+      for(size_t i = begin; i < end; ++i)
+        for(size_t j = high_offsets[i]; j < high_offsets[i + 1]; ++j)
+          co_bounds[thread_cnt[high_bounds[j].id()]++] = simplex_handle(k, i);
+    }
+  }
+
+  void topology_kernel::get_adjacent_relation(size_t d, std::vector<size_t>& offsets,
+                                              std::vector<simplex_handle>& adjacent) const
+  {
+    assert(gc_phase_ == GC_IDLE);
+    assert(d <= top_dim_ && top_dim_ > 0);
+    const size_t n = sm_.n_element(d);
+    if(d == 0)
+      {
+        // the adjacent vertexes are the other vertexes of the edges
+        get_k_co_boundary_relation(0, 1, offsets, adjacent);
+#pragma omp parallel for
+        for(size_t i = 0; i < n; ++i)
+          for(size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+            {
+              const simplex::boundary_type& edge = sm_.get_specific_simplex(adjacent[j]).get_boundary();
+              adjacent[j] = edge[0].id() == i ? edge[1] : edge[0];
+            }
+        return;
+      }
+
+    // the adjacent d-simplexes are the other d-simplexes sharing a facet
+    std::vector<size_t> facet_offsets, co_facet_offsets;
+    std::vector<simplex_handle> facets, co_facets;
+    get_k_boundary_relation(d, d - 1, facet_offsets, facets);
+    get_k_co_boundary_relation(d - 1, d, co_facet_offsets, co_facets);
+    offsets.resize(n + 1);
+    offsets[0] = 0;
+#pragma omp parallel for
+    for(size_t i = 0; i < n; ++i)
+      {
+        size_t num = 0;
+        for(size_t j = facet_offsets[i]; j < facet_offsets[i + 1]; ++j)
+          num += co_facet_offsets[facets[j].id() + 1] - co_facet_offsets[facets[j].id()] - 1;
+        offsets[i + 1] = num;
+      }
+    for(size_t i = 0; i < n; ++i)
+      offsets[i + 1] += offsets[i];
+    adjacent.resize(offsets[n]);
+#pragma omp parallel for
+    for(size_t i = 0; i < n; ++i)
+      {
+        size_t pos = offsets[i];
+        for(size_t j = facet_offsets[i]; j < facet_offsets[i + 1]; ++j)
+          for(size_t c = co_facet_offsets[facets[j].id()]; c < co_facet_offsets[facets[j].id() + 1]; ++c)
+            if(co_facets[c].id() != i)
+              adjacent[pos++] = co_facets[c];
+      }
+  }
+
   int topology_kernel::get_other_verts(const simplex_handle& sh, const std::vector<simplex_handle>& given_verts,
-                                       std::vector<simplex_handle>& other_verts)
+                                       std::vector<simplex_handle>& other_verts) const
   {
+    assert(gc_phase_ == GC_IDLE);
     assert(is_valid_handle(sh));
     assert(sh.dim() > 0);
-    std::vector<simplex_handle> verts;
+    simplex_handle verts[MAX_SIMPLEX_DIM + 1];
+    const size_t vert_num = get_simplex_verts(sh, verts);
     other_verts.clear();
-    get_k_boundary_simplex(sh, 0, verts);
-    for(size_t i = 0; i < given_verts.size(); ++i)
+    for(size_t i = 0;  i < vert_num; ++i)
       {
-        assert(!pm_.get_element_property<simplex_status>(given_verts[i], status_id_).is_set_flag(AUX_FLG));
-        pm_.get_element_property<simplex_status>(given_verts[i], status_id_).set_flag(AUX_FLG);
+        if(std::find(given_verts.begin(), given_verts.end(), verts[i]) == given_verts.end())
+          other_verts.push_back(verts[i]);
       }
-    for(size_t i = 0;  i < verts.size(); ++i)
+    return 0;
+  }
+
+  int topology_kernel::garbage_collector()
+  {
+    while(!collect_garbage(size_t(-1)));
+    return 0;
+  }
+
+  bool topology_kernel::collect_garbage(size_t max_num)
+  {
+    if(gc_phase_ == GC_IDLE)
       {
-        if(!pm_.get_element_property<simplex_status>(verts[i], status_id_).is_set_flag(AUX_FLG))
-          other_verts.push_back(verts[i]);
+        clear_vert_star();
+        for(size_t dim = 0; dim < free_slots_.size(); ++dim)
+          free_slots_[dim].clear();
+        gc_remap_.resize(top_dim_ + 1);
+        for(size_t dim = 0; dim <= top_dim_; ++dim)
+          gc_remap_[dim].resize(sm_.n_element(dim));
+        gc_num_.assign(top_dim_ + 1, 0);
+        mark_extra_co_bounds(0);
+        gc_phase_ = top_dim_ > 0 ? GC_MARK : GC_REMAP;
+        gc_dim_ = 0;
+        gc_pos_ = 0;
+      }
+    simplex_handle verts[MAX_SIMPLEX_DIM + 1];
+    size_t ids[MAX_SIMPLEX_DIM + 1];
+    while(gc_phase_ != GC_IDLE)
+      {
+        // the marks go down from the top dimension, the other passes go up
+        const size_t dim = (gc_phase_ == GC_MARK) ? top_dim_ - gc_dim_ : gc_dim_;
+        const size_t end = (gc_phase_ == GC_MARK || gc_phase_ == GC_REMAP || gc_phase_ == GC_MOVE) ?
+              gc_remap_[dim].size() : gc_num_[dim];
+        const size_t last = (end - gc_pos_ <= max_num) ? end : gc_pos_ + max_num;
+        max_num -= last - gc_pos_;
+        std::vector<size_t>& remap = gc_remap_[dim];
+        switch(gc_phase_)
+          {
+          case GC_MARK:
+            // the faces of the deleted simplexes lose a part of their star, so they are marked
+            for(; gc_pos_ < last; ++gc_pos_)
+              if((dim < top_dim_ && gc_marks_[dim][gc_pos_]) || is_simplex_deleted(simplex_handle(dim, gc_pos_)))
+                {
+                  const simplex::boundary_type& bounds =
+                      sm_.get_specific_simplex(simplex_handle(dim, gc_pos_)).get_boundary();
+                  for(size_t i = 0; i < bounds.size(); ++i)
+                    gc_marks_[dim - 1][bounds[i].id()] = true;
+                }
+            break;
+          case GC_REMAP:
+            // the remaining simplexes are numbered in their order, the deleted ones are skipped by words
+            std::fill(remap.begin() + gc_pos_, remap.begin() + last, size_t(-1));
+            for(size_t i = next_live_id(dim, gc_pos_); i < last; i = next_live_id(dim, i + 1))
+              {
+                // the new identifier is not larger than the old one, so the marks are moved in place
+                if(dim < top_dim_)
+                  gc_marks_[dim][gc_num_[dim]] = gc_marks_[dim][i];
+                remap[i] = gc_num_[dim]++;
+              }
+            gc_pos_ = last;
+            break;
+          case GC_MOVE:
+            // the new identifier is not larger than the old one, so the slot is free or a moved garbage
+            for(; gc_pos_ < last; ++gc_pos_)
+              if(remap[gc_pos_] != size_t(-1) && remap[gc_pos_] != gc_pos_)
+                {
+                  sm_.swap(dim, gc_pos_, remap[gc_pos_]);
+                  pm_.swap(dim, gc_pos_, remap[gc_pos_]);
+                }
+            break;
+          case GC_REWRITE:
+            for(; gc_pos_ < last; ++gc_pos_)
+              {
+                simplex& sim = sm_.get_specific_simplex(simplex_handle(dim, gc_pos_));
+                simplex::boundary_type& bounds = sim.get_boundary();
+                for(size_t i = 0; i < bounds.size(); ++i)
+                  {
+                    assert(gc_remap_[dim - 1][bounds[i].id()] != size_t(-1));
+                    bounds[i].set_id(gc_remap_[dim - 1][bounds[i].id()]);
+                  }
+                // the remap of reorder does not keep the order of the vertexes
+                if(dim > 0)
+                  sort_boundary(simplex_handle(dim, gc_pos_));
+                // the deleted simplexes left by del_simplex are dropped from the partial co_boundary,
+                // and the representative of a marked simplex is gathered again by the next dimension
+                simplex::par_co_boundary_type& co_bounds = sim.get_par_co_boundary();
+                if(is_co_bound_represented(dim) && gc_marks_[dim][gc_pos_])
+                  co_bounds.clear();
+                for(size_t i = co_bounds.size(); i > 0; --i)
+                  {
+                    const size_t id = gc_remap_[dim + 1][co_bounds[i - 1].id()];
+                    if(id == size_t(-1))
+                      co_bounds.erase(co_bounds.begin() + i - 1);
+                    else
+                      co_bounds[i - 1].set_id(id);
+                  }
+                if(dim == 0 || !is_co_bound_represented(dim - 1))
+                  continue;
+                // each remaining simplex is a co_boundary of its marked facets, the first one found
+                // is the representative and the others may be in the other parts of the star
+                for(size_t i = 0; i < bounds.size(); ++i)
+                  if(gc_marks_[dim - 1][bounds[i].id()])
+                    {
+                      simplex::par_co_boundary_type& facet_co_bounds =
+                          sm_.get_specific_simplex(bounds[i]).get_par_co_boundary();
+                      if(facet_co_bounds.empty())
+                        facet_co_bounds.push_back(simplex_handle(dim, gc_pos_));
+                      else
+                        extra_co_bounds_[bounds[i]].push_back(simplex_handle(dim, gc_pos_));
+                    }
+              }
+            break;
+          case GC_REHASH:
+            for(; gc_pos_ < last; ++gc_pos_)
+              {
+                const simplex_handle sh(dim, gc_pos_);
+                const size_t vert_num = get_simplex_verts(sh, verts);
+                for(size_t i = 0; i < vert_num; ++i)
+                  ids[i] = verts[i].id();
+                simplex_handle exist;
+                simplex2handle_[dim].insert(simplex_key(ids, vert_num), sh, exist);
+                if(is_top_verts_cached_ && dim == top_dim_)
+                  std::copy(ids, ids + vert_num, top_verts_.begin() + gc_pos_ * vert_num);
+              }
+            break;
+          default:
+            assert(0);
+          }
+        if(gc_pos_ < end)
+          return false;
+        next_gc_dim();
       }
-    for(size_t i = 0; i < given_verts.size(); ++i)
+    return true;
+  }
+
+  void topology_kernel::next_gc_dim()
+  {
+    if(gc_phase_ == GC_MOVE)
       {
-        assert(pm_.get_element_property<simplex_status>(given_verts[i], status_id_).is_set_flag(AUX_FLG));
-        pm_.get_element_property<simplex_status>(given_verts[i], status_id_).reset_flag(AUX_FLG);
+        sm_.resize(gc_dim_, gc_num_[gc_dim_]);
+        pm_.resize(gc_dim_, gc_num_[gc_dim_]);
+      }
+    gc_pos_ = 0;
+    // the vertexes have no facet to be marked
+    if(gc_dim_ + (gc_phase_ == GC_MARK ? 1 : 0) < top_dim_)
+      ++gc_dim_;
+    else if(gc_phase_ == GC_REHASH || (gc_phase_ == GC_REWRITE && top_dim_ == 0))
+      {
+        std::vector<std::vector<bool> >().swap(gc_marks_);
+        gc_phase_ = GC_IDLE;
+        return;
+      }
+    else
+      {
+        gc_phase_ = gc_phase_type(gc_phase_ + 1);
+        // the vertexes have no boundary and are not in the map
+        gc_dim_ = (gc_phase_ == GC_REHASH) ? 1 : 0;
+      }
+    if(gc_phase_ == GC_REHASH)
+      {
+        simplex2handle_[gc_dim_].clear();
+        simplex2handle_[gc_dim_].reserve(gc_num_[gc_dim_]);
+        if(is_top_verts_cached_ && gc_dim_ == top_dim_)
+          top_verts_.resize(gc_num_[gc_dim_] * (top_dim_ + 1));
       }
-    return 0;
   }
 
-  int topology_kernel::garbage_collector()
+  void topology_kernel::mark_extra_co_bounds(const std::vector<std::vector<size_t> >* remap)
   {
-    simplex_handle cur_left_sh, cur_right_sh;
+    gc_marks_.resize(top_dim_);
+    for(size_t dim = 0; dim < top_dim_; ++dim)
+      gc_marks_[dim].assign(sm_.n_element(dim), false);
+    for(extra_co_bound_map::const_iterator it = extra_co_bounds_.begin(); it != extra_co_bounds_.end(); ++it)
+      {
+        const simplex_handle& sh = it->first;
+        gc_marks_[sh.dim()][remap == 0 ? sh.id() : (*remap)[sh.dim()][sh.id()]] = true;
+      }
+    extra_co_bound_map().swap(extra_co_bounds_);
+  }
+
+  void topology_kernel::sort_boundary(const simplex_handle& sh)
+  {
+    assert(sh.dim() > 0);
+    simplex::boundary_type& bounds = sm_.get_specific_simplex(sh).get_boundary();
+    if(sh.dim() == 1)
+      {
+        if(bounds[0].id() > bounds[1].id())
+          std::swap(bounds[0], bounds[1]);
+        return;
+      }
+    // each vertex is in all the facets but one, so the vertex opposite to the facet i is
+    // the sum of all the facets divided by the dimension minus the sum of the facet i
+    std::pair<size_t, simplex_handle> facets[MAX_SIMPLEX_DIM + 1];
+    simplex_handle verts[MAX_SIMPLEX_DIM + 1];
+    size_t total = 0;
+    for(size_t i = 0; i < bounds.size(); ++i)
+      {
+        const size_t vert_num = get_simplex_verts(bounds[i], verts);
+        size_t sum = 0;
+        for(size_t j = 0; j < vert_num; ++j)
+          sum += verts[j].id();
+        facets[i] = std::make_pair(sum, bounds[i]);
+        total += sum;
+      }
+    total /= sh.dim();
+    for(size_t i = 0; i < bounds.size(); ++i)
+      facets[i].first = total - facets[i].first;
+    for(size_t i = 1; i < bounds.size(); ++i)
+      for(size_t j = i; j > 0 && facets[j - 1].first < facets[j].first; --j)
+        std::swap(facets[j - 1], facets[j]);
+    for(size_t i = 0; i < bounds.size(); ++i)
+      bounds[i] = facets[i].second;
+  }
+
+  /// This function spreads the lowest 21 bits of x to every third bit
+  static uint64_t spread_morton_bits(uint64_t x)
+  {
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x << 8) & 0x100f00f00f00f00fULL;
+    x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+    x = (x | x << 2) & 0x1249249249249249ULL;
+    return x;
+  }
+
+  /// a simplex sorted by reorder, it is ordered by its sorted vertexes
+  struct reorder_item
+  {
+    size_t verts[MAX_SIMPLEX_DIM + 1];
+    size_t id;
+  };
+
+  /// This functor compares two reorder items by the first n vertexes
+  struct reorder_item_less
+  {
+    reorder_item_less(size_t n):n_(n) {}
+    bool operator() (const reorder_item& lhs, const reorder_item& rhs) const
+    {
+      return std::lexicographical_compare(lhs.verts, lhs.verts + n_, rhs.verts, rhs.verts + n_);
+    }
+    size_t n_;
+  };
+
+  int topology_kernel::reorder()
+  {
+    garbage_collector();
+
+    // the vertexes along the Morton curve of the bounding box
+    const size_t vert_num = sm_.n_element(0);
+    const std::vector<vert_coord>& coords = coord_prop_->get_vector();
+    double min_x[3], max_x[3];
+    for(size_t j = 0; j < 3; ++j)
+      {
+        min_x[j] = vert_num == 0 ? 0 : coords[0].x[j];
+        max_x[j] = min_x[j];
+      }
+    for(size_t i = 0; i < vert_num; ++i)
+      for(size_t j = 0; j < 3; ++j)
+        {
+          min_x[j] = std::min(min_x[j], coords[i].x[j]);
+          max_x[j] = std::max(max_x[j], coords[i].x[j]);
+        }
+    const double cell_num = double(1 << 21) - 1;
+    double scale = 0;
+    for(size_t j = 0; j < 3; ++j)
+      scale = std::max(scale, max_x[j] - min_x[j]);
+    scale = scale > 0 ? cell_num / scale : 0;
+    std::vector<std::pair<uint64_t, size_t> > vert_keys(vert_num);
+    for(size_t i = 0; i < vert_num; ++i)
+      {
+        uint64_t key = 0;
+        for(size_t j = 0; j < 3; ++j)
+          key |= spread_morton_bits(uint64_t((coords[i].x[j] - min_x[j]) * scale)) << j;
+        vert_keys[i] = std::make_pair(key, i);
+      }
+    std::sort(vert_keys.begin(), vert_keys.end());
+    std::vector<std::vector<size_t> > new_ids(top_dim_ + 1);
+    new_ids[0].resize(vert_num);
+    for(size_t i = 0; i < vert_num; ++i)
+      new_ids[0][vert_keys[i].second] = i;
+
+    // the other simplexes by their new vertexes, so they follow the vertexes
+    std::vector<reorder_item> items;
+    simplex_handle verts[MAX_SIMPLEX_DIM + 1];
     for(size_t dim = 1; dim <= top_dim_; ++dim)
       {
-        const size_t cur_dim = dim;
-        size_t left = 0;
-        size_t right = sm_.n_element(cur_dim) - 1;
-        cur_left_sh.set_dim(cur_dim);
-        cur_left_sh.set_id(left);
-        cur_right_sh.set_dim(cur_dim);
-        cur_right_sh.set_id(right);
-        while(true)
+        const size_t n = sm_.n_element(dim);
+        items.resize(n);
+        for(size_t i = 0; i < n; ++i)
+          {
+            get_simplex_verts(simplex_handle(dim, i), verts);
+            for(size_t j = 0; j <= dim; ++j)
+              items[i].verts[j] = new_ids[0][verts[j].id()];
+            std::sort(items[i].verts, items[i].verts + dim + 1);
+            items[i].id = i;
+          }
+        // the vertexes of two simplexes are never the same, so the order is unique
+        std::sort(items.begin(), items.end(), reorder_item_less(dim + 1));
+        new_ids[dim].resize(n);
+        for(size_t i = 0; i < n; ++i)
+          new_ids[dim][items[i].id] = i;
+      }
+
+    // permute the storage, then rewrite the handles by the passes of the garbage collection, which
+    // gather the extra partial co_boundary again
+    mark_extra_co_bounds(&new_ids);
+    for(size_t dim = 0; dim <= top_dim_; ++dim)
+      {
+        permute_simplices(dim, new_ids[dim]);
+        std::vector<size_t>& remap = gc_remap_[dim];
+        for(size_t i = 0; i < remap.size(); ++i)
+          if(remap[i] != size_t(-1))
+            remap[i] = new_ids[dim][remap[i]];
+      }
+    gc_remap_.swap(new_ids);
+    gc_phase_ = GC_REWRITE;
+    gc_dim_ = 0;
+    gc_pos_ = 0;
+    collect_garbage(size_t(-1));
+    gc_remap_.swap(new_ids);
+    return 0;
+  }
+
+  void topology_kernel::permute_simplices(size_t dim, const std::vector<size_t>& new_ids)
+  {
+    // follow the cycles of the permutation, each swap puts one simplex into its slot
+    std::vector<size_t> pos(new_ids);
+    for(size_t i = 0; i < pos.size(); ++i)
+      while(pos[i] != i)
+        {
+          const size_t j = pos[i];
+          sm_.swap(dim, i, j);
+          pm_.swap(dim, i, j);
+          std::swap(pos[i], pos[j]);
+        }
+  }
+
+  /// the magic number of the snapshot files
+  static const char SNAPSHOT_MAGIC[8] = {'I', 'S', 'M', 'E', 'S', 'H', 'S', 'N'};
+
+  /// the version of the snapshot files, it changes whenever the layout changes
+  static const uint32_t SNAPSHOT_VERSION = 3;
+
+  /// the value written to detect the byte order of the snapshot files
+  static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+  /// the number of the simplexes converted at a time when a snapshot is written or read
+  static const size_t SNAPSHOT_CHUNK_SIZE = 1 << 14;
+
+  /** This function returns the number of the uint32_t in the record of a simplex of the dimension in
+    * a snapshot, the record has the sizes of the boundary and the partial co_boundary packed in one
+    * word, the identifiers of the boundary and two words for the partial co_boundary
+    */
+  static size_t snapshot_record_size(size_t dim)
+  {return 1 + (dim == 0 ? 0 : dim + 1) + 2;}
+
+  int topology_kernel::save_snapshot(std::ostream& os) const
+  {
+    if(coord_prop_ == 0 || gc_phase_ != GC_IDLE)
+      {
+        std::cerr << "# [error] the mesh is not created or is collecting garbage" << std::endl;
+        return __LINE__;
+      }
+    const uint32_t header[] = {SNAPSHOT_VERSION, SNAPSHOT_BYTE_ORDER, uint32_t(top_dim_)};
+    os.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    os.write((const char*)header, sizeof(header));
+    // the fields of the simplexes are written one by one, so the file does not depend on the layout
+    // of simplex and simplex_handle, the dimensions of the handles are implied
+    std::vector<uint32_t> buf;
+    for(size_t dim = 0; dim <= top_dim_; ++dim)
+      {
+        const std::vector<simplex>& sims = sm_.get_simplex_with_same_dim(dim);
+        const size_t rec = snapshot_record_size(dim);
+        const uint64_t n = sims.size();
+        os.write((const char*)&n, sizeof(n));
+        for(size_t i = 0; i < sims.size(); i += SNAPSHOT_CHUNK_SIZE)
           {
-            while(!is_simplex_deleted(cur_left_sh) && (left < right))
+            const size_t num = std::min(SNAPSHOT_CHUNK_SIZE, sims.size() - i);
+            buf.assign(num * rec, 0);
+            for(size_t j = 0; j < num; ++j)
               {
-                ++left;
-                cur_left_sh.set_id(left);
+                const simplex::boundary_type& bounds = sims[i + j].get_boundary();
+                const simplex::par_co_boundary_type& co_bounds = sims[i + j].get_par_co_boundary();
+                if(bounds.size() > rec - 3)
+                  return __LINE__;
+                uint32_t* p = &buf[j * rec];
+                *p++ = uint32_t(bounds.size() << 8 | co_bounds.size());
+                for(size_t k = 0; k < bounds.size(); ++k)
+                  p[k] = bounds[k].id();
+                p += rec - 3;
+                for(size_t k = 0; k < co_bounds.size(); ++k)
+                  p[k] = co_bounds[k].id();
               }
-            while(is_simplex_deleted(cur_right_sh) && (left < right))
+            os.write((const char*)&buf[0], buf.size() * sizeof(uint32_t));
+          }
+        if(status_props_[dim]->write(os))
+          return __LINE__;
+      }
+    if(write_pod_vector(os, coord_prop_->get_vector()))
+      return __LINE__;
+    for(size_t i = 1; i <= top_dim_; ++i)
+      if(simplex2handle_[i].write(os))
+        return __LINE__;
+    // the extra partial co_boundary is written as the dimension, the identifier, the number and the
+    // identifiers of the co_boundary of each simplex
+    std::vector<uint32_t> extras;
+    for(extra_co_bound_map::const_iterator it = extra_co_bounds_.begin(); it != extra_co_bounds_.end(); ++it)
+      {
+        extras.push_back(it->first.dim());
+        extras.push_back(it->first.id());
+        extras.push_back(uint32_t(it->second.size()));
+        for(size_t i = 0; i < it->second.size(); ++i)
+          extras.push_back(it->second[i].id());
+      }
+    if(write_pod_vector(os, extras))
+      return __LINE__;
+    return os.fail() ? __LINE__ : 0;
+  }
+
+  int topology_kernel::load_snapshot(std::istream& is)
+  {
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    uint32_t header[3];
+    is.read(magic, sizeof(magic));
+    is.read((char*)header, sizeof(header));
+    if(is.fail() || !std::equal(magic, magic + sizeof(magic), SNAPSHOT_MAGIC) ||
+       header[0] != SNAPSHOT_VERSION || header[1] != SNAPSHOT_BYTE_ORDER || header[2] > MAX_SIMPLEX_DIM)
+      {
+        std::cerr << "# [error] not a snapshot of this version" << std::endl;
+        return __LINE__;
+      }
+    set_dim(header[2]);
+    const int err = read_snapshot_data(is);
+    if(err != 0)
+      {
+        std::cerr << "# [error] the snapshot is damaged at line " << err << std::endl;
+        set_dim(0);
+        return err;
+      }
+    if(is_top_verts_cached_)
+      set_top_verts_cached(true);
+    if(is_slot_reused_)
+      set_slot_reused(true);
+    return 0;
+  }
+
+  int topology_kernel::read_snapshot_data(std::istream& is)
+  {
+    std::vector<uint32_t> buf;
+    for(size_t dim = 0; dim <= top_dim_; ++dim)
+      {
+        std::vector<simplex>& sims = sm_.get_simplex_with_same_dim(dim);
+        const size_t rec = snapshot_record_size(dim);
+        uint64_t n = 0;
+        is.read((char*)&n, sizeof(n));
+        if(is.fail() || remaining_bytes(is) / (rec * sizeof(uint32_t)) < n)
+          return __LINE__;
+        sims.resize(n);
+        for(size_t i = 0; i < sims.size(); i += SNAPSHOT_CHUNK_SIZE)
+          {
+            const size_t num = std::min(SNAPSHOT_CHUNK_SIZE, sims.size() - i);
+            buf.resize(num * rec);
+            is.read((char*)&buf[0], buf.size() * sizeof(uint32_t));
+            if(is.fail())
+              return __LINE__;
+            for(size_t j = 0; j < num; ++j)
               {
-                --right;
-                cur_right_sh.set_id(right);
+                const uint32_t* p = &buf[j * rec];
+                const size_t bound_num = p[0] >> 8, co_bound_num = p[0] & 0xff;
+                // the boundary of a vertex is empty and the partial co_boundary of a top simplex too
+                if(bound_num != rec - 3 || co_bound_num > 2 || (dim == top_dim_ && co_bound_num != 0))
+                  return __LINE__;
+                simplex::boundary_type& bounds = sims[i + j].get_boundary();
+                simplex::par_co_boundary_type& co_bounds = sims[i + j].get_par_co_boundary();
+                bounds.clear();
+                co_bounds.clear();
+                // the identifiers are checked against the sizes after all the dimensions are read
+                for(size_t k = 0; k < bound_num; ++k)
+                  {
+                    if(p[1 + k] >= simplex_handle::ID_MASK)
+                      return __LINE__;
+                    bounds.push_back(simplex_handle(dim - 1, p[1 + k]));
+                  }
+                for(size_t k = 0; k < co_bound_num; ++k)
+                  {
+                    if(p[rec - 2 + k] >= simplex_handle::ID_MASK)
+                      return __LINE__;
+                    co_bounds.push_back(simplex_handle(dim + 1, p[rec - 2 + k]));
+                  }
               }
-            if(left >= right)
-              break;
-            sm_.swap(cur_dim, left, right);
-            pm_.swap(cur_dim, left, right);
           }
-        sm_.resize(cur_dim, is_simplex_deleted(cur_left_sh) ? left : left + 1);
-        pm_.resize(cur_dim, is_simplex_deleted(cur_left_sh) ? left : left + 1);
+        if(status_props_[dim]->read(is) || status_props_[dim]->n_elements() != sm_.n_element(dim))
+          return __LINE__;
+      }
+    if(read_pod_vector(is, coord_prop_->get_vector()) || coord_prop_->n_elements() != sm_.n_element(0))
+      return __LINE__;
+    for(size_t i = 1; i <= top_dim_; ++i)
+      if(simplex2handle_[i].read(is))
+        return __LINE__;
+    std::vector<uint32_t> extras;
+    if(read_pod_vector(is, extras))
+      return __LINE__;
+    for(size_t i = 0; i < extras.size(); i += 3 + extras[i + 2])
+      {
+        if(extras.size() - i < 3 || !is_co_bound_represented(extras[i]) ||
+           extras[i + 1] >= sm_.n_element(extras[i]) || extras.size() - i - 3 < extras[i + 2])
+          return __LINE__;
+        std::vector<simplex_handle>& co_bounds = extra_co_bounds_[simplex_handle(extras[i], extras[i + 1])];
+        for(size_t j = 0; j < extras[i + 2]; ++j)
+          {
+            if(extras[i + 3 + j] >= sm_.n_element(extras[i] + 1))
+              return __LINE__;
+            co_bounds.push_back(simplex_handle(extras[i] + 1, extras[i + 3 + j]));
+          }
+      }
+
+    // the handles must refer to the simplexes of the neighboring dimensions
+    for(size_t dim = 0; dim <= top_dim_; ++dim)
+      for(size_t i = 0; i < sm_.n_element(dim); ++i)
+        {
+          const simplex& sim = sm_.get_specific_simplex(simplex_handle(dim, i));
+          const simplex::boundary_type& bounds = sim.get_boundary();
+          const simplex::par_co_boundary_type& co_bounds = sim.get_par_co_boundary();
+          for(size_t j = 0; j < bounds.size(); ++j)
+            if(bounds[j].id() >= sm_.n_element(dim - 1))
+              return __LINE__;
+          for(size_t j = 0; j < co_bounds.size(); ++j)
+            if(co_bounds[j].id() >= sm_.n_element(dim + 1))
+              return __LINE__;
+        }
+
+    // each live simplex must be found in the map by the key of its increasing vertexes, and the map
+    // must have no other entry, so the queries and new_simplex agree with the simplexes
+    for(size_t dim = 1; dim <= top_dim_; ++dim)
+      {
+        const simplex_hash_table& table = simplex2handle_[dim];
+        if(table.size() != n_live_elements(dim))
+          return __LINE__;
+        const size_t simplex_num = sm_.n_element(dim);
+        size_t bad_id = simplex_num;
+#pragma omp parallel for reduction(min:bad_id)
+        for(size_t i = 0; i < simplex_num; ++i)
+          {
+            const simplex_handle sh(dim, i);
+            if(is_simplex_deleted(sh))
+              continue;
+            simplex_handle verts[MAX_SIMPLEX_DIM + 1];
+            size_t ids[MAX_SIMPLEX_DIM + 1];
+            get_simplex_verts(sh, verts);
+            bool is_ok = true;
+            for(size_t j = 0; j <= dim; ++j)
+              {
+                ids[j] = verts[j].id();
+                is_ok = is_ok && (j == 0 || ids[j - 1] < ids[j]);
+              }
+            if(!is_ok || table.find(simplex_key(ids, dim + 1)) != sh)
+              bad_id = std::min(bad_id, i);
+          }
+        if(bad_id != simplex_num)
+          return __LINE__;
       }
     return 0;
   }
 
-  int topology_kernel::new_tet(const std::vector<size_t>& verts, simplex_handle& sh)
+  int topology_kernel::new_tet(const size_t* verts, simplex_handle& sh)
   {
-    assert(verts.size() == 4);
+    const size_t vert_num = 4;
     const int face_num = 4;
     const int edge_num = 6;
-    std::vector<simplex_handle> face_shs, edge_shs;
-    std::vector<bool> is_new_face, is_new_edge;
-    face_shs.reserve(face_num); is_new_face.reserve(face_num);
-    edge_shs.reserve(edge_num); is_new_edge.reserve(edge_num);
-    std::vector<size_t> face_verts(3), edge_verts(2);
-    simplex_handle face_sh, edge_sh;
+    simplex_handle face_shs[face_num], edge_shs[edge_num];
+    bool is_new_face[face_num], is_new_edge[edge_num];
+    size_t face_verts[3], edge_verts[2];
     bool is_new;
 
-    new_simplex(verts, sh, is_new);
+    if(new_simplex(verts, vert_num, sh, is_new))
+      return __LINE__;
     assert(is_new);
 
-    for(size_t i = 0; i < verts.size(); ++i)
-      for(size_t j = i + 1; j < verts.size(); ++j)
-        for(size_t k = j + 1; k < verts.size(); ++k)
+    size_t cnt = 0;
+    for(size_t i = 0; i < vert_num; ++i)
+      for(size_t j = i + 1; j < vert_num; ++j)
+        for(size_t k = j + 1; k < vert_num; ++k, ++cnt)
           {
             face_verts[0] = verts[i];
             face_verts[1] = verts[j];
             face_verts[2] = verts[k];
-            new_simplex(face_verts, face_sh, is_new);
-            face_shs.push_back(face_sh);
-            is_new_face.push_back(is_new);
+            if(new_simplex(face_verts, 3, face_shs[cnt], is_new_face[cnt]))
+              return __LINE__;
           }
 
-    for(size_t i = 0; i < verts.size(); ++i)
-      for(size_t j = i + 1; j < verts.size(); ++j)
+    cnt = 0;
+    for(size_t i = 0; i < vert_num; ++i)
+      for(size_t j = i + 1; j < vert_num; ++j, ++cnt)
         {
           edge_verts[0] = verts[i];
           edge_verts[1] = verts[j];
-          new_simplex(edge_verts, edge_sh, is_new);
-          edge_shs.push_back(edge_sh);
-          is_new_edge.push_back(is_new);
+          if(new_simplex(edge_verts, 2, edge_shs[cnt], is_new_edge[cnt]))
+            return __LINE__;
         }
 
-    sm_.get_specific_simplex(sh).get_boundary() = face_shs;
+    sm_.get_specific_simplex(sh).get_boundary().assign(face_shs, face_shs + face_num);
 
     const int face2edge[] = {0, 1, 3,
                              0, 2, 4,
                              1, 2, 5,
                              3, 4, 5};
-    for(size_t i = 0; i < face_shs.size(); ++i)
+    for(size_t i = 0; i < face_num; ++i)
       {
         sm_.get_specific_simplex(face_shs[i]).get_par_co_boundary().push_back(sh);
         assert(sm_.get_specific_simplex(face_shs[i]).par_co_boundary_size() <= 2);
         if(is_new_face[i])
           {
-            std::vector<simplex_handle>& face_bounds =
+            simplex::boundary_type& face_bounds =
                 sm_.get_specific_simplex(face_shs[i]).get_boundary();
             assert(face_bounds.size() == 0);
             for(size_t j = 0; j < 3; ++j)
@@ -512,153 +2038,112 @@ namespace is_mesh
       }
 
     const int edge2face[] = {0, 2, 1, 3, 3, 3};
-    for(size_t i = 0; i < edge_shs.size(); ++i)
+    for(size_t i = 0; i < edge_num; ++i)
       {
-        std::vector<simplex_handle>& co_bound =
-            sm_.get_specific_simplex(edge_shs[i]).get_par_co_boundary();
-        if(is_new_edge[i])
-          {
-            assert(co_bound.size() == 0);
-            co_bound.push_back(face_shs[edge2face[i]]);
-          }
-        else
-          {
-            assert(co_bound.size() == 1);
-            co_bound[0] = face_shs[edge2face[i]];
-          }
-
+        assert(!is_new_edge[i] || sm_.get_specific_simplex(edge_shs[i]).par_co_boundary_size() == 0);
+        set_co_bound_representative(edge_shs[i], face_shs[edge2face[i]]);
       }
 
     const int vert2edge[] = {0, 3, 5, 2};
-    for(size_t i = 0; i < verts.size(); ++i)
-      {
-        std::vector<simplex_handle>& co_bound =
-            sm_.get_specific_simplex(simplex_handle(0, verts[i])).get_par_co_boundary();
-        if(co_bound.size() == 0)
-          co_bound.push_back(edge_shs[vert2edge[i]]);
-        else
-          co_bound[0] = edge_shs[vert2edge[i]];
-      }
+    for(size_t i = 0; i < vert_num; ++i)
+      set_co_bound_representative(simplex_handle(0, verts[i]), edge_shs[vert2edge[i]]);
     return 0;
   }
 
-  int topology_kernel::new_tri(const std::vector<size_t>& verts, simplex_handle& sh)
+  int topology_kernel::new_tri(const size_t* verts, simplex_handle& sh)
   {
-    assert(verts.size() == 3);
-    std::vector<simplex_handle> edge_shs;
-    std::vector<size_t> edge_verts(2);
-    simplex_handle edge_sh;
+    const size_t vert_num = 3;
+    const int edge_num = 3;
+    simplex_handle edge_shs[edge_num];
+    size_t edge_verts[2];
     bool is_new;
 
-    new_simplex(verts, sh, is_new);
+    if(new_simplex(verts, vert_num, sh, is_new))
+      return __LINE__;
     assert(is_new);
 
-    for(size_t i = 0; i < verts.size(); ++i)
-      for(size_t j = i + 1; j < verts.size(); ++j)
+    size_t cnt = 0;
+    for(size_t i = 0; i < vert_num; ++i)
+      for(size_t j = i + 1; j < vert_num; ++j, ++cnt)
         {
           edge_verts[0] = verts[i];
           edge_verts[1] = verts[j];
-          new_simplex(edge_verts, edge_sh, is_new);
-          edge_shs.push_back(edge_sh);
+          if(new_simplex(edge_verts, 2, edge_shs[cnt], is_new))
+            return __LINE__;
         }
-    assert(edge_shs.size() == 3);
-    sm_.get_specific_simplex(sh).get_boundary() = edge_shs;
+    sm_.get_specific_simplex(sh).get_boundary().assign(edge_shs, edge_shs + edge_num);
 
-    for(size_t i = 0; i < edge_shs.size(); ++i)
+    for(size_t i = 0; i < edge_num; ++i)
       {
         sm_.get_specific_simplex(edge_shs[i]).get_par_co_boundary().push_back(sh);
         assert(sm_.get_specific_simplex(edge_shs[i]).par_co_boundary_size() <= 2);
       }
 
     const int vert2edge[] = {0, 2, 1};
-    for(size_t i = 0; i < verts.size(); ++i)
-      {
-        std::vector<simplex_handle>& co_bound =
-            sm_.get_specific_simplex(simplex_handle(0, verts[i])).get_par_co_boundary();
-        if(co_bound.size() == 0)
-          co_bound.push_back(edge_shs[vert2edge[i]]);
-        else
-          co_bound[0] = edge_shs[vert2edge[i]];
-      }
+    for(size_t i = 0; i < vert_num; ++i)
+      set_co_bound_representative(simplex_handle(0, verts[i]), edge_shs[vert2edge[i]]);
     return 0;
   }
 
   /// make sure the verts is sorted
-  int topology_kernel::new_simplex(const std::vector<size_t>& verts, simplex_handle& sh, bool& is_new)
+  int topology_kernel::new_simplex(const size_t* verts, size_t n, simplex_handle& sh, bool& is_new)
   {
-    assert(verts.size() <= top_dim_ + 1  && verts.size() >= 2);
-    const size_t cur_dim = verts.size() - 1;
-    map_type::iterator it = simplex2handle_[cur_dim].find(verts);
-    if(it == simplex2handle_[cur_dim].end())
+    assert(n <= top_dim_ + 1  && n >= 2);
+    const size_t cur_dim = n - 1;
+    const size_t slot = is_slot_reused_ ? get_free_slot(cur_dim) : size_t(-1);
+    if(slot == size_t(-1) && check_id_range(cur_dim, 1))
+      return __LINE__;
+    const simplex_handle new_sh(cur_dim, slot != size_t(-1) ? slot : sm_.n_element(cur_dim));
+    is_new = simplex2handle_[cur_dim].insert(simplex_key(verts, n), new_sh, sh);
+    if(is_new)
       {
+        sh = new_sh;
         simplex sim;
-        sim.get_boundary().reserve(cur_dim + 1);
         if(cur_dim == 1)
           {
             sim.get_boundary().push_back(simplex_handle(0, verts[0]));
             sim.get_boundary().push_back(simplex_handle(0, verts[1]));
             assert(sim.boundary_size() == 2);
           }
-        sm_.push_back(cur_dim, sim);
-        pm_.resize(cur_dim, sm_.n_element(cur_dim));
-        sh.set_dim(cur_dim);
-        sh.set_id(sm_.n_element(cur_dim) - 1);
-        is_new = true;
-        simplex2handle_[cur_dim].insert(std::make_pair(verts, sh));
-      }
-    else
-      {
-        sh = it->second;
-        is_new = false;
+        if(slot != size_t(-1))
+          {
+            free_slots_[cur_dim].pop_back();
+            sm_.get_specific_simplex(new_sh) = sim;
+            pm_.reset(cur_dim, slot);
+          }
+        else
+          {
+            sm_.push_back(cur_dim, sim);
+            pm_.resize(cur_dim, sm_.n_element(cur_dim));
+          }
       }
     return 0;
   }
 
 
-  bool topology_kernel::is_belong(const simplex_handle& low_sh, const simplex_handle& high_sh)
+  bool topology_kernel::is_belong(const simplex_handle& low_sh, const simplex_handle& high_sh) const
   {
-    bool flg = false;
-    if(low_sh.dim() < high_sh.dim())
-      {
-        std::vector<simplex_handle> bounds;
-        get_k_boundary_simplex(high_sh, low_sh.dim(), bounds);
-        for(size_t i = 0; i < bounds.size(); ++i)
-          {
-            if(bounds[i] == low_sh)
-              {
-                flg = true;
-                break;
-              }
-          }
-      }
-    return flg;
+    if(low_sh.dim() >= high_sh.dim())
+      return false;
+    simplex_handle low_verts[MAX_SIMPLEX_DIM + 1], high_verts[MAX_SIMPLEX_DIM + 1];
+    const size_t low_num = get_simplex_verts(low_sh, low_verts);
+    const size_t high_num = get_simplex_verts(high_sh, high_verts);
+    return std::includes(high_verts, high_verts + high_num, low_verts, low_verts + low_num);
   }
 
-  bool topology_kernel::is_belong(const std::vector<simplex_handle>& low_shs, const simplex_handle& high_sh)
+  bool topology_kernel::is_belong(const simplex::boundary_type& low_shs, const simplex_handle& high_sh) const
   {
-    bool flg = false;
     assert(low_shs.size() != 0);
+    if(low_shs[0].dim() >= high_sh.dim())
+      return false;
+    simplex_handle low_verts[MAX_SIMPLEX_DIM + 1], high_verts[MAX_SIMPLEX_DIM + 1];
+    const size_t high_num = get_simplex_verts(high_sh, high_verts);
     for(size_t i = 0; i < low_shs.size(); ++i)
       {
-        assert(!pm_.get_element_property<simplex_status>(low_shs[i], status_id_).is_set_flag(AUX_FLG));
-        pm_.get_element_property<simplex_status>(low_shs[i], status_id_).set_flag(AUX_FLG);
+        const size_t low_num = get_simplex_verts(low_shs[i], low_verts);
+        if(std::includes(high_verts, high_verts + high_num, low_verts, low_verts + low_num))
+          return true;
       }
-    if(low_shs[0].dim() < high_sh.dim())
-      {
-        std::vector<simplex_handle> bounds;
-        get_k_boundary_simplex(high_sh, low_shs[0].dim(), bounds);
-        for(size_t i = 0; i < bounds.size(); ++i)
-          if(pm_.get_element_property<simplex_status>(bounds[i], status_id_).is_set_flag(AUX_FLG))
-            {
-              flg = true;
-              break;
-            }
-      }
-    for(size_t i = 0; i < low_shs.size(); ++i)
-      {
-        assert(pm_.get_element_property<simplex_status>(low_shs[i], status_id_).is_set_flag(AUX_FLG));
-        pm_.get_element_property<simplex_status>(low_shs[i], status_id_).reset_flag(AUX_FLG);
-      }
-    return flg;
+    return false;
   }
 }
@@ -2,17 +2,33 @@
 #define IS_TOPOLOGY_KERNEL_H
 
 #include "../property/property_manager.h"
-#include "../property/status.h"
+#include "../property/status_property.h"
 #include "../simplex/simplex_manager.h"
+#include "query_context.h"
+#include "simplex_hash_table.h"
 
-#include <boost/unordered_map.hpp>
+#include <boost/static_assert.hpp>
 #include <zjucad/matrix/matrix.h>
+#include <zjucad/matrix/itr_matrix.h>
 
 namespace is_mesh
 {
   /// an alias used to define the type of coordinate
   typedef zjucad::matrix::matrix<double> coord_type;
 
+  /// an alias used to define the read-only view of the coordinates stored in the mesh
+  typedef zjucad::matrix::itr_matrix<const double*> coord_view_type;
+
+  /**
+    * This struct stores the coordinate of a vertex as three packed doubles, so the coordinates
+    * of all vertexes are stored in one contiguous array and can be viewed as a 3*N matrix.
+    */
+  struct vert_coord
+  {
+    double x[3];
+  };
+  BOOST_STATIC_ASSERT(sizeof(vert_coord) == 3 * sizeof(double));
+
   /**
     * This class is a topology kernel of the mesh, it includes some basic operations, such
     * as query adjacent information and construct the mesh.
@@ -22,15 +38,23 @@ namespace is_mesh
   public:
 
     /// an alias used to define the type of simplex with same dimension to handle map
-    typedef boost::unordered_map<std::vector<size_t>, simplex_handle> map_type;
+    typedef simplex_hash_table map_type;
 
     /// an alias used to define the type all simplex to handle type
-    typedef std::vector<boost::unordered_map<std::vector<size_t>, simplex_handle > > simplex2handle_type;
+    typedef std::vector<simplex_hash_table> simplex2handle_type;
 
     /// This member function creates a new instance of this class.
-    topology_kernel(): top_dim_(0), pm_(0), sm_(0), status_id_(-1), coord_id_(-1)
+    topology_kernel(): top_dim_(0), pm_(0), sm_(0), status_id_(-1), coord_id_(-1), coord_prop_(0),
+      is_top_verts_cached_(false), is_slot_reused_(false), gc_phase_(GC_IDLE), gc_dim_(0), gc_pos_(0),
+      is_vert_star_built_(false)
     {}
 
+    /// copy construct function
+    topology_kernel(const topology_kernel& rhs);
+
+    /// assignment construct function
+    topology_kernel& operator= (const topology_kernel& rhs);
+
     /** This function set the dimension of the mesh, and add some basic properties to the mesh.
       * \param top_dim the dimension of the top simplex of the mesh
       */
@@ -89,7 +113,7 @@ namespace is_mesh
       */
     bool is_simplex_visited(const simplex_handle& sh) const
     {
-      return pm_.get_element_property<simplex_status>(sh, status_id_).is_visited();
+      return is_status_set(sh, VISITED);
     }
 
     /** This function set the simplex to be visited
@@ -97,7 +121,7 @@ namespace is_mesh
       */
     void set_simplex_visited(const simplex_handle& sh)
     {
-      pm_.get_element_property<simplex_status>(sh, status_id_).set_visited();
+      set_status_flag(sh, VISITED);
     }
 
     /** This function set the simplex not to be visited
@@ -105,7 +129,7 @@ namespace is_mesh
       */
     void reset_simplex_visited(const simplex_handle& sh)
     {
-      pm_.get_element_property<simplex_status>(sh, status_id_).reset_visited();
+      reset_status_flag(sh, VISITED);
     }
 
     /** This function returns the simplex is deleted
@@ -114,25 +138,64 @@ namespace is_mesh
       */
     bool is_simplex_deleted(const simplex_handle& sh) const
     {
-      return pm_.get_element_property<simplex_status>(sh, status_id_).is_deleted();
+      return is_status_set(sh, DELETED);
     }
 
-    /** This function set the simplex to be deleted
+    /** This function set the simplex to be deleted, the simplex can not be found by its vertexes
+      * any more, and its slot is reused by the new simplexes if set_slot_reused is enabled
+      * \param sh the handle of given simplex
+      */
+    void set_simplex_deleted(const simplex_handle& sh);
+
+    /** This function set the simplex not to be deleted, it fails and the simplex keeps deleted if
+      * a live simplex with the same vertexes exists
       * \param sh the handle of given simplex
+      * \return 0 if operation suncess othervise non-zero
       */
-    void set_simplex_deleted(const simplex_handle& sh)
+    int reset_simplex_deleted(const simplex_handle& sh);
+
+    /** This function returns the number of the simplexes of the dimension which are not deleted,
+      * the deleted flags are counted word by word
+      * \param dim the given dimension
+      * \return the number of the simplexes which are not deleted
+      */
+    size_t n_live_elements(const simplex_dim& dim) const
     {
-      pm_.get_element_property<simplex_status>(sh, status_id_).set_deleted();
+      assert(dim < status_props_.size());
+      return status_props_[dim]->n_elements() - status_props_[dim]->count_flag(DELETED);
     }
 
-    /** This function set the simplex not to be deleted
-      * \param sh the handle of given simplex
+    /** This function finds the first simplex of the dimension not before id which is not deleted,
+      * the deleted simplexes are skipped word by word
+      * \param dim the given dimension
+      * \param id the identifier the search starts from
+      * \return the identifier of the found simplex, it is n_elements(dim) if there is none
       */
-    void reset_simplex_deleted(const simplex_handle& sh)
+    size_t next_live_id(const simplex_dim& dim, size_t id) const
     {
-      pm_.get_element_property<simplex_status>(sh, status_id_).reset_deleted();
+      assert(dim < status_props_.size());
+      return status_props_[dim]->find_next(DELETED, id, false);
     }
 
+    /** This function enables or disables the reuse of the slots of the deleted simplexes. When it
+      * is enabled, new_vert, new_top_simplex and the simplexes created by them take the slots freed
+      * by set_simplex_deleted before growing the storage, and the properties of a reused slot are
+      * reset to the default values, so the storage keeps bounded under the repeated topology
+      * operations without garbage_collector. Note that a new simplex may have a smaller identifier
+      * than the existing ones, and a deleted simplex must not be referred by the partial co_boundary
+      * of the remaining simplexes any more, which holds for topology_operation but not for
+      * del_simplex. So del_simplex fails while it is enabled, and garbage_collector must be called
+      * before enabling it if del_simplex was used. It is disabled by default.
+      * \param flg true to enable the reuse, false to disable it
+      */
+    void set_slot_reused(bool flg);
+
+    /** This function returns whether the slots of the deleted simplexes are reused
+      * \return true if the reuse is enabled, otherwise false
+      */
+    bool is_slot_reused() const
+    {return is_slot_reused_;}
+
     /** This function returns a simplex handle is valid or not
       * \param sh the given handle
       * \return true if the handle is valid, otherwise false
@@ -147,22 +210,50 @@ namespace is_mesh
       * \param sh the simplex handle of given vertex
       * \param coord the coordinate of the vertex we want to set
       */
-    void set_coord(const simplex_handle& sh, const coord_type& coord)
+    template <typename M>
+    void set_coord(const simplex_handle& sh, const M& coord)
     {
+      assert(gc_phase_ == GC_IDLE);
       assert(sh.dim() == 0);
       assert(is_valid_handle(sh));
-      pm_.get_element_property<coord_type>(sh, coord_id_) = coord;
+      assert(coord.size() == 3);
+      double* x = (*coord_prop_)[sh.id()].x;
+      for(size_t i = 0; i < 3; ++i)
+        x[i] = coord[i];
     }
 
-    /** This function returns the coordinate of the given vertex
+    /** This function returns the coordinate of the given vertex, it is a view of the coordinate
+      * stored in the mesh, so it is invalidated when the vertexes are added or removed.
       * \param sh the simplex handle of given vertex
       * \return the coordinate of the given vertex
       */
-    const coord_type& get_coord(const simplex_handle& sh) const
+    coord_view_type get_coord(const simplex_handle& sh) const
+    {
+      return coord_view_type(3, 1, get_coord_ptr(sh));
+    }
+
+    /** This function returns the pointer to the coordinate of the given vertex
+      * \param sh the simplex handle of given vertex
+      * \return the pointer to the three doubles of the coordinate
+      */
+    const double* get_coord_ptr(const simplex_handle& sh) const
     {
+      assert(gc_phase_ == GC_IDLE);
       assert(sh.dim() == 0);
       assert(is_valid_handle(sh));
-      return pm_.get_element_property<coord_type>(sh, coord_id_);
+      return (*coord_prop_)[sh.id()].x;
+    }
+
+    /** This function returns the coordinates of all vertexes as a 3*N matrix without copying them
+      * \return the coordinates of all vertexes
+      */
+    coord_view_type get_coords() const
+    {
+      assert(gc_phase_ == GC_IDLE);
+      // the vert_coord array is viewed as packed doubles, see the size assertion of vert_coord
+      const std::vector<vert_coord>& coords = coord_prop_->get_vector();
+      return coord_view_type(3, coords.size(),
+                             coords.empty() ? 0 : reinterpret_cast<const double*>(&coords[0]));
     }
 
     /** This function new a top simplex
@@ -187,11 +278,48 @@ namespace is_mesh
       */
     int new_vert(size_t id, const coord_type& coord, simplex_handle& sh);
 
+    /** This function new vertexes in bulk, their coordinates are copied in one pass
+      * \param node the coordinates of the new vertexes, it is a 3*N matrix
+      * \return 0 if operation suncess othervise non-zero
+      */
+    int new_verts(const matrixd& node);
+
+    /** This function new vertexes in bulk from an array of coordinates
+      * \param coords the coordinates of the new vertexes, the three of each vertex are adjacent
+      * \param num the number of the new vertexes
+      * \return 0 if operation suncess othervise non-zero, it fails if the identifiers of the new
+      * vertexes reach simplex_handle::ID_MASK
+      */
+    int new_verts(const double* coords, size_t num);
+
+    /** This function new top simplexes in bulk. If the mesh has no simplex except vertexes, the
+      * sub simplexes of all the cells are deduplicated by radix sorting their vertexes instead of
+      * looking up the hash table one by one, and the result is the same as calling new_top_simplex
+      * on each cell in order. Otherwise new_top_simplex is called on each cell. The work is split
+      * across the OpenMP threads, and the result does not depend on the number of the threads.
+      * \param cells the vertex indexes of the top simplexes, it is a (top_dim + 1)*M matrix
+      * \return 0 if operation suncess othervise non-zero. In the bulk path the mesh is not changed
+      * if the cells are duplicated, degenerated or non-manifold, otherwise it stops at the first
+      * cell failed by new_top_simplex and the cells before it are kept in the mesh
+      */
+    int new_top_simplices(const matrixst& cells);
+
+    /** This function new top simplexes in bulk as above, but the cells are given in a vector which is
+      * used as the work space, so the cells are not copied again
+      * \param cells the vertex indexes of the top simplexes, the top_dim + 1 vertexes of each cell
+      * are adjacent, its content is unspecified after the call
+      * \return 0 if operation suncess othervise non-zero
+      */
+    int new_top_simplices(std::vector<size_t>& cells);
+
     /** This function delete the simplex, in other words, it set the simplex and its' all
       * co_bounadry simplex deleted, be cautious to use it, because when the simplex set deleted,
       * it may causes errors when querying adjacent information. So make sure you need not query
-      * adjacent information about deleted simplex when you use this function.
+      * adjacent information about deleted simplex when you use this function. The partial
+      * co_boundary of the remaining simplexes may still refer the deleted simplexes until
+      * garbage_collector, so it fails while set_slot_reused is enabled.
       * \param sh the handle of simplex to be deleted
+      * \return 0 if operation suncess othervise non-zero
       */
     int del_simplex(const simplex_handle& sh);
 
@@ -199,103 +327,485 @@ namespace is_mesh
       * \param sh the handle of given simplex
       * \param bounds it stores all boundary simplex of the given simplex
       */
-    void get_all_boundary_simplex(const simplex_handle& sh, std::vector<simplex_handle>& bounds);
+    void get_all_boundary_simplex(const simplex_handle& sh, std::vector<simplex_handle>& bounds)
+    {get_all_boundary_simplex(sh, bounds, ctx_);}
+
+    /** This function used to query all boundary simplex of the given simplex with the scratch buffers
+      * of the given context, the query does not allocate memory if bounds and ctx are reused. The query
+      * does not change the mesh, so it can run in parallel with other queries using other contexts.
+      * \param sh the handle of given simplex
+      * \param bounds it stores all boundary simplex of the given simplex
+      * \param ctx the query context
+      */
+    void get_all_boundary_simplex(const simplex_handle& sh, std::vector<simplex_handle>& bounds,
+                                  query_context& ctx) const;
 
     /** This function used to query the given dimension boundary simplex of the given simplex
       * \param sh the handle of given simplex
       * \param k the given dimesion
       * \param bounds it stores given dimension boundary simplex of the given simplex
       */
-    void get_k_boundary_simplex(const simplex_handle& sh, size_t k, std::vector<simplex_handle>& bounds);
+    void get_k_boundary_simplex(const simplex_handle& sh, size_t k, std::vector<simplex_handle>& bounds)
+    {get_k_boundary_simplex(sh, k, bounds, ctx_);}
+
+    /** This function used to query the given dimension boundary simplex of the given simplex with the
+      * scratch buffers of the given context
+      * \param sh the handle of given simplex
+      * \param k the given dimesion
+      * \param bounds it stores given dimension boundary simplex of the given simplex
+      * \param ctx the query context
+      */
+    void get_k_boundary_simplex(const simplex_handle& sh, size_t k, std::vector<simplex_handle>& bounds,
+                                query_context& ctx) const;
 
     /** This function used to query all co-boundary simplex of the given simplex
       * \param sh the handle of given simplex
       * \param co_bounds it stores all co-boundary simplex of the given simplex
       */
-    void get_all_co_boundary_simplex(const simplex_handle& sh, std::vector<simplex_handle>& co_bounds);
+    void get_all_co_boundary_simplex(const simplex_handle& sh, std::vector<simplex_handle>& co_bounds)
+    {get_all_co_boundary_simplex(sh, co_bounds, ctx_);}
+
+    /** This function used to query all co-boundary simplex of the given simplex with the scratch buffers
+      * of the given context
+      * \param sh the handle of given simplex
+      * \param co_bounds it stores all co-boundary simplex of the given simplex
+      * \param ctx the query context
+      */
+    void get_all_co_boundary_simplex(const simplex_handle& sh, std::vector<simplex_handle>& co_bounds,
+                                     query_context& ctx) const;
 
     /** This function used to query the given dimension co-boundary simplex of the given simplex
       * \param sh the handle of given simplex
       * \param k the given dimesion
       * \param bounds it stores given dimension co-boundary simplex of the given simplex
       */
-    void get_k_co_boundary_simplex(const simplex_handle& sh, size_t k, std::vector<simplex_handle>& co_bounds);
+    void get_k_co_boundary_simplex(const simplex_handle& sh, size_t k, std::vector<simplex_handle>& co_bounds)
+    {get_k_co_boundary_simplex(sh, k, co_bounds, ctx_);}
+
+    /** This function used to query the given dimension co-boundary simplex of the given simplex with the
+      * scratch buffers of the given context
+      * \param sh the handle of given simplex
+      * \param k the given dimesion
+      * \param bounds it stores given dimension co-boundary simplex of the given simplex
+      * \param ctx the query context
+      */
+    void get_k_co_boundary_simplex(const simplex_handle& sh, size_t k, std::vector<simplex_handle>& co_bounds,
+                                   query_context& ctx) const;
 
     /** This function used to query all adjacent simplex of the given simplex
       * \param sh the handle of given simplex
       * \param adjacent it stores all adjacent simplex of the given simplex
       */
-    void get_adjacent_simplex(const simplex_handle& sh, std::vector<simplex_handle>& adjacent);
+    void get_adjacent_simplex(const simplex_handle& sh, std::vector<simplex_handle>& adjacent)
+    {get_adjacent_simplex(sh, adjacent, ctx_);}
 
-    /** This function get other vertexs except for the given vertexs from all vertexs of the given simplex
+    /** This function used to query all adjacent simplex of the given simplex with the scratch buffers
+      * of the given context
       * \param sh the handle of given simplex
-      * \param given_verts the given vertexs
-      * \param other_verts it stores other vertexs
-      * \return 0 if the operation success othe-wise non-zero
+      * \param adjacent it stores all adjacent simplex of the given simplex
+      * \param ctx the query context
       */
-    int get_other_verts(const simplex_handle& sh, const std::vector<simplex_handle>& given_verts,
-                        std::vector<simplex_handle>& other_verts);
+    void get_adjacent_simplex(const simplex_handle& sh, std::vector<simplex_handle>& adjacent,
+                              query_context& ctx) const;
+
+    /** This function gets the k-boundary of all the d-simplexes in one sweep as compressed sparse rows,
+      * the k-boundary of the i'th d-simplex is stored in [offsets[i], offsets[i + 1]) of bounds. The
+      * vertexes are in the order of get_simplex_verts and the others in the lexicographic order of
+      * their vertexes, the rows of the deleted simplexes are empty. It runs in parallel with OpenMP.
+      * \param d the dimension of the given simplexes
+      * \param k the dimension of the boundary, it must be less than d
+      * \param offsets it stores the n_elements(d) + 1 offsets of the rows
+      * \param bounds it stores the rows
+      */
+    void get_k_boundary_relation(size_t d, size_t k, std::vector<size_t>& offsets,
+                                 std::vector<simplex_handle>& bounds) const;
+
+    /** This function gets the k-co_boundary of all the d-simplexes in one sweep as compressed sparse
+      * rows, the k-co_boundary of the i'th d-simplex is stored in [offsets[i], offsets[i + 1]) of
+      * co_bounds in the ascending order of the identifiers, the deleted k-simplexes are skipped.
+      * It runs in parallel with OpenMP.
+      * \param d the dimension of the given simplexes
+      * \param k the dimension of the co_boundary, it must be larger than d
+      * \param offsets it stores the n_elements(d) + 1 offsets of the rows
+      * \param co_bounds it stores the rows
+      */
+    void get_k_co_boundary_relation(size_t d, size_t k, std::vector<size_t>& offsets,
+                                    std::vector<simplex_handle>& co_bounds) const;
+
+    /** This function gets the adjacent simplexes of all the d-simplexes in one sweep as compressed
+      * sparse rows, the result of the i'th d-simplex is the same set as get_adjacent_simplex, it is
+      * stored in [offsets[i], offsets[i + 1]) of adjacent. The adjacent vertexes are the vertexes
+      * sharing an edge, the others are the d-simplexes sharing a facet, which are grouped by the
+      * facets. The rows of the deleted simplexes are empty. It runs in parallel with OpenMP.
+      * \param d the dimension of the given simplexes
+      * \param offsets it stores the n_elements(d) + 1 offsets of the rows
+      * \param adjacent it stores the rows
+      */
+    void get_adjacent_relation(size_t d, std::vector<size_t>& offsets,
+                               std::vector<simplex_handle>& adjacent) const;
 
-    /// This function remove the deleted simplex, be careful when using it, it will change the handle
-    /// of the simplex.
-    int garbage_collector();
+    /** This function gets the vertexes of the given simplex by indexing the boundary directly instead
+      * of a traversal. The boundary built by new_tri and new_tet has a fixed layout: an edge (a,b) stores
+      * [a, b], a triangle (a,b,c) stores [ab, ac, bc] and a tet (a,b,c,d) stores [abc, abd, acd, bcd],
+      * so the vertexes are got in the same order as get_k_boundary_simplex(sh, 0, ...).
+      * \param sh the handle of given simplex
+      * \param verts it stores the vertexes of the given simplex, its size must be at least sh.dim() + 1
+      * \return the number of the vertexes
+      */
+    size_t get_simplex_verts(const simplex_handle& sh, simplex_handle* verts) const
+    {
+      assert(is_valid_handle(sh));
+      switch(sh.dim())
+        {
+        case 0:
+          verts[0] = sh;
+          return 1;
+        case 1:
+          {
+            const simplex::boundary_type& edge = sm_.get_specific_simplex(sh).get_boundary();
+            verts[0] = edge[0];
+            verts[1] = edge[1];
+            return 2;
+          }
+        case 2:
+          {
+            const simplex::boundary_type& tri = sm_.get_specific_simplex(sh).get_boundary();
+            const simplex::boundary_type& ab = sm_.get_specific_simplex(tri[0]).get_boundary();
+            verts[0] = ab[0];
+            verts[1] = ab[1];
+            verts[2] = sm_.get_specific_simplex(tri[1]).get_boundary()[1];
+            return 3;
+          }
+        case 3:
+          {
+            const simplex::boundary_type& tet = sm_.get_specific_simplex(sh).get_boundary();
+            get_simplex_verts(tet[0], verts);
+            const simplex::boundary_type& abd = sm_.get_specific_simplex(tet[1]).get_boundary();
+            verts[3] = sm_.get_specific_simplex(abd[1]).get_boundary()[1];
+            return 4;
+          }
+        default:
+          assert(0);
+        }
+      return 0;
+    }
 
-  protected:
+    /** This function returns the memory allocated by the mesh, it includes the simplexes, the
+      * properties, the hash tables and the caches, but not the scratch buffers of the queries.
+      * \return the memory allocated by the mesh in bytes
+      */
+    size_t memory_usage() const;
 
-    int new_simplex(const std::vector<size_t>& verts, simplex_handle& sh, bool& is_new);
+    /** This function enables or disables the cache of the vertexes of the top simplexes. When it is
+      * enabled, the vertexes of each top simplex are stored in a (top_dim + 1) * N array which is kept
+      * up to date by new_top_simplex, del_simplex and garbage_collector.
+      * \param flg true to enable the cache, false to disable and free it
+      */
+    void set_top_verts_cached(bool flg);
 
-    int new_tet(const std::vector<size_t>& verts, simplex_handle& sh);
+    /** This function returns whether the vertexes of the top simplexes are cached
+      * \return true if the cache is enabled, otherwise false
+      */
+    bool is_top_verts_cached() const
+    {return is_top_verts_cached_;}
 
-    int new_tri(const std::vector<size_t>& verts, simplex_handle& sh);
+    /** This function returns the cached vertexes of the given top simplex, the cache must be enabled.
+      * The vertexes are in the same order as get_simplex_verts.
+      * \param sh the handle of given top simplex
+      * \return the pointer to top_dim + 1 vertex indexes
+      */
+    const size_t* get_top_simplex_verts(const simplex_handle& sh) const
+    {
+      assert(gc_phase_ == GC_IDLE);
+      assert(is_top_verts_cached_);
+      assert(sh.dim() == top_dim_ && is_valid_handle(sh));
+      return &top_verts_[sh.id() * (top_dim_ + 1)];
+    }
 
-    bool is_belong(const simplex_handle& low_sh, const simplex_handle& high_sh);
+    /** This function returns the cached vertexes of all top simplexes, the vertexes of the i'th top
+      * simplex are stored in [i * (top_dim + 1), (i + 1) * (top_dim + 1)), they are -1 for a top
+      * simplex deleted by del_simplex.
+      * \return the cached vertexes of all top simplexes
+      */
+    const std::vector<size_t>& get_top_verts() const
+    {
+      assert(is_top_verts_cached_);
+      return top_verts_;
+    }
 
-    bool is_belong(const std::vector<simplex_handle>& low_shs, const simplex_handle& high_sh);
+    /** This function builds the vertex star index, it stores the k-simplexes containing each vertex
+      * for every k > 0 in compressed sparse rows, in the ascending order of their identifiers. When it
+      * is built, the co_boundary queries and the adjacent query of a vertex scan and intersect the
+      * rows instead of traversing the partial co_boundary. The index is for the static meshes only,
+      * it is not updated by the appends: new_top_simplex, new_top_simplices, the topology operations
+      * which call them, garbage_collector, reorder, load_snapshot and set_dim drop it, and the queries
+      * go back to the traversal until it is built again. The simplexes deleted by del_simplex are
+      * skipped by the queries, and the vertexes added later have empty rows.
+      */
+    void build_vert_star();
 
+    /// This function drops the vertex star index and releases its memory
+    void clear_vert_star();
 
-    bool is_simplex_bound_visited(const simplex_handle& sh) const
+    /** This function returns whether the vertex star index is built
+      * \return true if the index is built, otherwise false
+      */
+    bool is_vert_star_built() const
+    {return is_vert_star_built_;}
+
+    /** This function returns the k-simplexes containing the given vertex from the vertex star index,
+      * the index must be built, the deleted simplexes are included.
+      * \param vert the handle of given vertex
+      * \param k the given dimension, it must be in [1, top_dim]
+      * \param star it points to the first k-simplex containing the vertex
+      * \return the number of the k-simplexes containing the vertex
+      */
+    size_t get_vert_star(const simplex_handle& vert, size_t k, const simplex_handle*& star) const
     {
-      return pm_.get_element_property<simplex_status>(sh, status_id_).is_bound_visited();
+      assert(is_vert_star_built_);
+      assert(vert.dim() == 0 && k > 0 && k <= top_dim_);
+      const std::vector<size_t>& offsets = vert_star_offsets_[k];
+      if(vert.id() + 1 >= offsets.size())
+        {
+          star = 0;
+          return 0;
+        }
+      star = vert_star_[k].empty() ? 0 : &vert_star_[k][0] + offsets[vert.id()];
+      return offsets[vert.id() + 1] - offsets[vert.id()];
     }
 
-    void set_simplex_bound_visited(const simplex_handle& sh)
-    {
-      pm_.get_element_property<simplex_status>(sh, status_id_).set_bound_visited();
-    }
+    /** This function get other vertexs except for the given vertexs from all vertexs of the given simplex
+      * \param sh the handle of given simplex
+      * \param given_verts the given vertexs
+      * \param other_verts it stores other vertexs
+      * \return 0 if the operation success othe-wise non-zero
+      */
+    int get_other_verts(const simplex_handle& sh, const std::vector<simplex_handle>& given_verts,
+                        std::vector<simplex_handle>& other_verts) const;
+
+    /** This function removes the deleted simplexes of all the dimensions, the remaining simplexes keep
+      * their order and get consecutive identifiers, and the boundary, the partial co_boundary, the map
+      * from the vertexes to the handles and the cache of the top vertexes are rewritten with the new
+      * identifiers. The old handles held by the callers can be mapped by get_gc_remap. If an
+      * incremental collection is in progress, it is finished.
+      * A vertex, or an edge of a tet mesh, stores one representative of its co_boundary, which is
+      * not enough after del_simplex since the remaining star may be split into several parts, so
+      * the co_boundary of each remaining face of the deleted simplexes is gathered again from the
+      * boundary of the remaining simplexes, the first one is the representative and the others are
+      * kept in a sparse table which the queries visit too.
+      * \return 0 if operation suncess othervise non-zero
+      */
+    int garbage_collector();
+
+    /** This function runs the garbage collection incrementally, each call processes at most max_num
+      * simplexes in one of the linear passes of garbage_collector, so the work of a call is bounded.
+      * The mesh must not be queried or modified until the collection is finished, the queries, the
+      * coordinate accessors and the modifications assert it, garbage_collector and reorder finish
+      * the collection first.
+      * \param max_num the maximum number of the simplexes processed by this call
+      * \return true if the collection is finished, otherwise false
+      */
+    bool collect_garbage(size_t max_num);
+
+    /** This function returns whether an incremental garbage collection is in progress
+      * \return true if a collection is in progress, otherwise false
+      */
+    bool is_collecting_garbage() const
+    {return gc_phase_ != GC_IDLE;}
+
+    /** This function renumbers the simplexes for the locality of the memory access. The vertexes are
+      * sorted along the Morton curve of their coordinates, and the other simplexes are sorted by their
+      * sorted vertexes, so the simplexes sharing vertexes are close to each other in the storage. The
+      * simplexes and all their properties are permuted, the handles stored in the mesh are rewritten
+      * as garbage_collector does, and the deleted simplexes are removed first. The old handles held
+      * by the callers can be mapped by get_gc_remap. It helps the meshes whose storage lost the
+      * locality, such as after many topology operations, the order of a mesh read from a well ordered
+      * file may be as good already.
+      * \return 0 if operation suncess othervise non-zero
+      */
+    int reorder();
 
-    void reset_simplex_bound_visited(const simplex_handle& sh)
+    /** This function returns the new identifiers given by the last finished garbage collection or
+      * reorder
+      * \param dim the given dimension
+      * \return the new identifier of each old identifier of the dimension, it is -1 for a deleted
+      * simplex
+      */
+    const std::vector<size_t>& get_gc_remap(size_t dim) const
     {
-      pm_.get_element_property<simplex_status>(sh, status_id_).reset_bound_visited();
+      assert(gc_phase_ == GC_IDLE && dim < gc_remap_.size());
+      return gc_remap_[dim];
     }
 
-    bool is_simplex_co_bound_visited(const simplex_handle& sh) const
+    /** This function maps an old handle by the last finished garbage collection or reorder
+      * \param sh the old handle
+      * \return the new handle, it is null if the simplex was deleted
+      */
+    simplex_handle get_gc_handle(const simplex_handle& sh) const
     {
-      return pm_.get_element_property<simplex_status>(sh, status_id_).is_co_bound_visited();
+      const std::vector<size_t>& remap = get_gc_remap(sh.dim());
+      assert(sh.id() < remap.size());
+      return remap[sh.id()] == size_t(-1) ? simplex_handle() : simplex_handle(sh.dim(), remap[sh.id()]);
     }
 
-    void set_simplex_co_bound_visited(const simplex_handle& sh)
+    /** This function writes a snapshot of the mesh, it stores the boundary and the partial
+      * co_boundary of the simplexes, the status, the coordinates, the slots of the hash tables and
+      * the extra partial co_boundary field by field, so load_snapshot restores the mesh without
+      * building the simplexes and the hash tables again. The deleted simplexes are kept, call
+      * garbage_collector first for a smaller file. The other properties are not stored.
+      * \param os the output stream, it must be binary
+      * \return 0 if operation suncess othervise non-zero
+      */
+    int save_snapshot(std::ostream& os) const;
+
+    /** This function reads a snapshot written by save_snapshot of the same version on a machine with
+      * the same byte order. The handles of the snapshot, the layout of the boundaries and every
+      * slot of the hash tables are checked against the simplexes, so a damaged file is rejected
+      * instead of breaking the queries and the updates. The vertex star index is not built, and
+      * the cache of the
+      * vertexes of the top simplexes and the free slots are rebuilt if they are enabled.
+      * \param is the input stream, it must be binary
+      * \return 0 if operation suncess othervise non-zero, the mesh is empty on failure
+      */
+    int load_snapshot(std::istream& is);
+
+  protected:
+    /// the passes of the garbage collection
+    enum gc_phase_type
     {
-      pm_.get_element_property<simplex_status>(sh, status_id_).set_co_bound_visited();
-    }
+      GC_IDLE,
+      GC_MARK,
+      GC_REMAP,
+      GC_MOVE,
+      GC_REWRITE,
+      GC_REHASH
+    };
+
+    /// This function moves the garbage collection to the next dimension or pass
+    void next_gc_dim();
+
+    /** This function marks the simplexes having the extra partial co_boundary for the garbage
+      * collection and clears the table, so their co_boundary is gathered again
+      * \param remap the new identifiers of each dimension, the identifiers are kept if it is null
+      */
+    void mark_extra_co_bounds(const std::vector<std::vector<size_t> >* remap);
+
+    /** This function returns whether the partial co_boundary of the dimension stores only one
+      * representative, which holds for the simplexes below the facets of the top simplexes
+      * \param dim the given dimension
+      * \return true if the partial co_boundary is a representative, otherwise false
+      */
+    bool is_co_bound_represented(size_t dim) const
+    {return dim + 2 <= top_dim_;}
+
+    /** This function sets the representative of the co_boundary of the simplex to a new co_boundary,
+      * the old one is moved to the extra partial co_boundary if the simplex has one
+      * \param sh the handle of the simplex
+      * \param co_sh the handle of the new co_boundary simplex
+      */
+    void set_co_bound_representative(const simplex_handle& sh, const simplex_handle& co_sh);
+
+    /** This function removes a deleted simplex from the extra partial co_boundary of its facets,
+      * a facet whose representative is deleted takes one of the extra ones
+      * \param sh the handle of the deleted simplex
+      */
+    void remove_extra_co_bound(const simplex_handle& sh);
 
-    void reset_simplex_co_bound_visited(const simplex_handle& sh)
+    /** This function pushes the extra partial co_boundary of the simplex into the queue of a query
+      * \param sh the handle of the simplex
+      * \param visited the visited simplexes of the query
+      * \param q the queue of the query
+      */
+    void push_extra_co_bounds(const simplex_handle& sh, handle_set& visited, handle_queue& q) const
     {
-      pm_.get_element_property<simplex_status>(sh, status_id_).reset_co_bound_visited();
+      if(extra_co_bounds_.empty() || !is_co_bound_represented(sh.dim()))
+        return;
+      const extra_co_bound_map::const_iterator it = extra_co_bounds_.find(sh);
+      if(it == extra_co_bounds_.end())
+        return;
+      for(size_t i = 0; i < it->second.size(); ++i)
+        if(visited.insert(it->second[i]))
+          q.push(it->second[i]);
     }
 
-    bool is_simplex_adjacent_visited(const simplex_handle& sh) const
+    /** This function puts the facets of the simplex into the lexicographic order of its vertexes,
+      * the facet opposite to the largest vertex is the first, the facets must be in order already.
+      * \param sh the handle of the simplex, its dimension must not be 0
+      */
+    void sort_boundary(const simplex_handle& sh);
+
+    /// This function moves the simplex i of the dimension and its properties to the slot new_ids[i]
+    void permute_simplices(size_t dim, const std::vector<size_t>& new_ids);
+
+    /** This function reads the data of a snapshot after its header into the empty mesh
+      * \return 0 if operation suncess othervise non-zero
+      */
+    int read_snapshot_data(std::istream& is);
+
+    int new_simplex(const size_t* verts, size_t n, simplex_handle& sh, bool& is_new);
+
+    int new_sorted_top_simplex(size_t* verts, simplex_handle& sh);
+
+    /** This function returns the slot of a deleted simplex to be reused
+      * \param dim the dimension of the simplex
+      * \return the index of the slot, it is -1 if there is no free slot
+      */
+    size_t get_free_slot(const simplex_dim& dim);
+
+    /** This function checks that the handles can identify num more simplexes of the dimension, the
+      * identifiers must be less than simplex_handle::ID_MASK, which is kept for the null handle
+      * \param dim the dimension of the new simplexes
+      * \param num the number of the new simplexes
+      * \return 0 if the identifiers are enough othervise non-zero
+      */
+    int check_id_range(const simplex_dim& dim, size_t num) const;
+
+    int new_tet(const size_t* verts, simplex_handle& sh);
+
+    int new_tri(const size_t* verts, simplex_handle& sh);
+
+    /** This function tests whether the lower simplex is a face of the higher simplex, the vertexes got
+      * by get_simplex_verts are sorted, so it is a subset test of two short sorted arrays.
+      * \param low_sh the handle of the lower simplex
+      * \param high_sh the handle of the higher simplex
+      * \return true if low_sh is a face of high_sh, otherwise false
+      */
+    bool is_belong(const simplex_handle& low_sh, const simplex_handle& high_sh) const;
+
+    /** This function tests whether one of the lower simplexes is a face of the higher simplex
+      * \param low_shs the handles of the lower simplexes with the same dimension
+      * \param high_sh the handle of the higher simplex
+      * \return true if one of low_shs is a face of high_sh, otherwise false
+      */
+    bool is_belong(const simplex::boundary_type& low_shs, const simplex_handle& high_sh) const;
+
+    /// This function gets the k-co_boundary of the simplex by intersecting the vertex stars
+    void get_star_k_co_boundary(const simplex_handle& sh, size_t k, std::vector<simplex_handle>& co_bounds) const;
+
+    /// This function gets the vertexes sharing an edge with the vertex from the vertex star
+    void get_star_adjacent_verts(const simplex_handle& sh, std::vector<simplex_handle>& adjacent) const;
+
+
+    /// This function resolves the status and coordinate properties, it must be called whenever
+    /// the properties of the property manager are reallocated.
+    void bind_props();
+
+    bool is_status_set(const simplex_handle& sh, unsigned int flag) const
     {
-      return pm_.get_element_property<simplex_status>(sh, status_id_).is_adjacent_visited();
+      assert(sh.dim() < status_props_.size());
+      return status_props_[sh.dim()]->is_set_flag(sh.id(), flag);
     }
 
-    void set_simplex_adjacent_visited(const simplex_handle& sh)
+    void set_status_flag(const simplex_handle& sh, unsigned int flag)
     {
-      pm_.get_element_property<simplex_status>(sh, status_id_).set_adjacent_visited();
+      assert(sh.dim() < status_props_.size());
+      status_props_[sh.dim()]->set_flag(sh.id(), flag);
     }
 
-    void reset_simplex_adjacent_visited(const simplex_handle& sh)
+    void reset_status_flag(const simplex_handle& sh, unsigned int flag)
     {
-      pm_.get_element_property<simplex_status>(sh, status_id_).reset_adjacent_visited();
+      assert(sh.dim() < status_props_.size());
+      status_props_[sh.dim()]->reset_flag(sh.id(), flag);
     }
 
   protected:
@@ -314,8 +824,67 @@ namespace is_mesh
     /// coordinate property index
     int coord_id_;
 
+    /// status property of each dimension, resolved from the property manager
+    std::vector<property<simplex_status>*> status_props_;
+
+    /// coordinate property of the vertexes, resolved from the property manager
+    property<vert_coord>* coord_prop_;
+
     /// the dimension of the top simplex of the mesh
     size_t top_dim_;
+
+    /// the query context used by the queries which are not given a context
+    query_context ctx_;
+
+    /// the co_boundary got in del_simplex
+    std::vector<simplex_handle> del_co_bounds_;
+
+    /// whether the vertexes of the top simplexes are cached
+    bool is_top_verts_cached_;
+
+    /// the cached vertexes of the top simplexes, see get_top_verts
+    std::vector<size_t> top_verts_;
+
+    /// whether the slots of the deleted simplexes are reused
+    bool is_slot_reused_;
+
+    /// the slots of the deleted simplexes of each dimension, a slot may be stale if its simplex
+    /// was restored by reset_simplex_deleted
+    std::vector<std::vector<size_t> > free_slots_;
+
+    /// the current pass of the garbage collection
+    gc_phase_type gc_phase_;
+
+    /// the dimension and the position of the current pass of the garbage collection
+    size_t gc_dim_, gc_pos_;
+
+    /// the new identifiers of the simplexes of each dimension given by the garbage collection,
+    /// they are -1 for the deleted simplexes
+    std::vector<std::vector<size_t> > gc_remap_;
+
+    /// the number of the remaining simplexes of each dimension
+    std::vector<size_t> gc_num_;
+
+    /// the faces of the deleted simplexes of each dimension marked by the garbage collection, whose
+    /// co_boundary is gathered again
+    std::vector<std::vector<bool> > gc_marks_;
+
+    /// an alias used to define the table of the extra partial co_boundary
+    typedef std::map<simplex_handle, std::vector<simplex_handle> > extra_co_bound_map;
+
+    /// the co_boundary simplexes other than the representative of the simplexes whose star was split
+    /// by del_simplex, see garbage_collector, the table is empty for the meshes not deleted
+    extra_co_bound_map extra_co_bounds_;
+
+    /// whether the vertex star index is built
+    bool is_vert_star_built_;
+
+    /// the k-simplexes containing the vertex i are stored in
+    /// [vert_star_offsets_[k][i], vert_star_offsets_[k][i + 1]) of vert_star_[k]
+    std::vector<std::vector<size_t> > vert_star_offsets_;
+
+    /// the vertex stars of each dimension, see vert_star_offsets_
+    std::vector<std::vector<simplex_handle> > vert_star_;
   };
 }
 
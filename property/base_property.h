@@ -46,11 +46,21 @@ namespace is_mesh
       */
     virtual void swap(size_t id0, size_t id1) = 0;
 
+    /** This function resets a property to the default value
+      * \param id the index of the property
+      */
+    virtual void reset(size_t id) = 0;
+
     /** This function return the number of the element of the current property
       * \return the number of the element of the vurrent property
       */
     virtual size_t n_elements() const = 0;
 
+    /** This function returns the memory allocated by the property
+      * \return the memory allocated by the property in bytes
+      */
+    virtual size_t memory_usage() const = 0;
+
     /** This function clone the current property
       * \return a pointer to the clone property
       */
@@ -44,9 +44,15 @@ namespace is_mesh
     /// This function swap two properties, see base_property
     virtual void swap(size_t id0, size_t id1) {std::swap(pro_vec_[id0], pro_vec_[id1]);}
 
+    /// This function resets a property to the default value, see base_property
+    virtual void reset(size_t id) {pro_vec_[id] = value_type();}
+
     /// This function return the number of the element of the current property, see base_property
     virtual size_t n_elements() const {return pro_vec_.size();}
 
+    /// This function returns the memory allocated by the property, see base_property
+    virtual size_t memory_usage() const {return pro_vec_.capacity() * sizeof(T);}
+
     /// This function clone the current property, see base_property
     virtual base_property* clone() const
     {
@@ -75,6 +81,18 @@ namespace is_mesh
       return pro_vec_[id];
     }
 
+    /** This function returns the vector which stores the element property, it is a const version
+      * \return the vector which stores the element property
+      */
+    const vector_type& get_vector() const
+    {return pro_vec_;}
+
+    /** This function returns the vector which stores the element property
+      * \return the vector which stores the element property
+      */
+    vector_type& get_vector()
+    {return pro_vec_;}
+
   private:
     /// vector to store the element property
     vector_type pro_vec_;
@@ -3,6 +3,10 @@
 
 #include "../simplex/simplex_handle.h"
 #include "simplex_property.h"
+#include "status.h"
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 namespace is_mesh
 {
@@ -73,6 +77,16 @@ namespace is_mesh
       mesh_property_[dim].swap(id0, id1);
     }
 
+    /** This function resets the properties of a simplex to the default values
+      * \param dim the dimension of the simplex
+      * \param id the index of the simplex
+      */
+    void reset(const simplex_dim& dim, size_t id)
+    {
+      assert(dim >= 0 && dim < mesh_property_.size());
+      mesh_property_[dim].reset(id);
+    }
+
     /** This function returns the number of properties of the given dimension simplex
       * \param dim the given dimension
       * \return the number of properties of the given dimension simplex
@@ -93,6 +107,16 @@ namespace is_mesh
       return mesh_property_[dim].n_elements();
     }
 
+    /** This function returns the memory allocated by the properties of the given dimension simplex
+      * \param dim the given dimension
+      * \return the memory allocated by the properties in bytes
+      */
+    size_t memory_usage(const simplex_dim& dim) const
+    {
+      assert(dim >= 0 && dim < mesh_property_.size());
+      return mesh_property_[dim].memory_usage();
+    }
+
     /** This function remove the property by given the dimension and the property index
       * \param dim the dimension of simplex which the property belonging to
       * \param prop_id the index of the property
@@ -171,6 +195,8 @@ namespace is_mesh
     template<class T>
     const T& get_element_property(const simplex_handle& sh, int prop_id) const
     {
+      // the status is packed into bitsets, so there is no reference to a simplex_status
+      BOOST_STATIC_ASSERT((!boost::is_same<T, simplex_status>::value));
       const simplex_dim dim = sh.dim();
       const simplex_dim ele_id = sh.id();
       const property<T>& props = get_specific_prop<T>(dim, prop_id);
@@ -185,6 +211,8 @@ namespace is_mesh
     template<class T>
     T& get_element_property(const simplex_handle &sh, int prop_id)
     {
+      // the status is packed into bitsets, so there is no reference to a simplex_status
+      BOOST_STATIC_ASSERT((!boost::is_same<T, simplex_status>::value));
       const simplex_dim& dim = sh.dim();
       const simplex_dim& ele_id = sh.id();
       property<T>& props = get_specific_prop<T>(dim, prop_id);
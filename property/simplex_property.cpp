@@ -64,4 +64,9 @@ namespace is_mesh
   {
     std::for_each(dim_property_.begin(), dim_property_.end(), swap_functor(id0, id1));
   }
+
+  void simplex_property::reset(size_t id)
+  {
+    std::for_each(dim_property_.begin(), dim_property_.end(), reset_functor(id));
+  }
 }
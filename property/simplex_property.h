@@ -58,6 +58,11 @@ namespace is_mesh
       */
     void swap(size_t id0, size_t id1);
 
+    /** This function resets the properties of a simplex to the default values
+      * \param id the index of the simplex
+      */
+    void reset(size_t id);
+
     /** This function returns the size of property, in other words, the number of properties
       * \return the size of property
       */
@@ -78,13 +83,26 @@ namespace is_mesh
       return elements;
     }
 
+    /** This function returns the memory allocated by all the properties
+      * \return the memory allocated by all the properties in bytes
+      */
+    size_t memory_usage() const
+    {
+      size_t bytes = dim_property_.capacity() * sizeof(base_property*);
+      for(size_t i = 0; i < dim_property_.size(); ++i)
+        if(dim_property_[i] != NULL)
+          bytes += dim_property_[i]->memory_usage();
+      return bytes;
+    }
+
     /** This function returns the index of the given property, the property was decided by its' name
       * \return the index of the given property in the vector
       */
     template<class T>
     int get_specific_prop_index(const T&, const std::string& prop_name) const;
 
-    /** This function returns the given property by its' index, it is a const version
+    /** This function returns the given property by its' index, it is a const version. The type of the
+      * property is only checked in debug mode, so resolve the property once and index it directly in hot loops.
       * \param prop_id the given index of the property
       * \return the property
       */
@@ -166,6 +184,17 @@ namespace is_mesh
       size_t id0_, id1_;
     };
 
+    struct reset_functor
+    {
+      reset_functor(size_t id):id_(id) {}
+      void operator() (base_property* p) const
+      {
+        if(p != NULL)
+          p->reset(id_);
+      }
+      size_t id_;
+    };
+
     struct delete_functor
     {
       delete_functor() {}
@@ -199,18 +228,16 @@ namespace is_mesh
   inline const property<T>& simplex_property::get_specific_prop(size_t prop_id) const
   {
     assert(prop_id >= 0 && prop_id < dim_property_.size() && dim_property_[prop_id] != NULL);
-    property<T>* p = dynamic_cast<property<T>*>(dim_property_[prop_id]);
-    assert(p != NULL);
-    return *p;
+    assert(dynamic_cast<property<T>*>(dim_property_[prop_id]) != NULL);
+    return *static_cast<property<T>*>(dim_property_[prop_id]);
   }
 
   template<class T>
   inline property<T>& simplex_property::get_specific_prop(size_t prop_id)
   {
     assert(prop_id >= 0 && prop_id < dim_property_.size() && dim_property_[prop_id] != NULL);
-    property<T>* p = dynamic_cast<property<T>*>(dim_property_[prop_id]);
-    assert(p != NULL);
-    return *p;
+    assert(dynamic_cast<property<T>*>(dim_property_[prop_id]) != NULL);
+    return *static_cast<property<T>*>(dim_property_[prop_id]);
   }
 
   template<class T>
@@ -0,0 +1,304 @@
+#ifndef IS_STATUS_PROPERTY_H
+#define IS_STATUS_PROPERTY_H
+
+#include "property.h"
+#include "status.h"
+
+#include <stdint.h>
+
+namespace is_mesh
+{
+  /// the number of the status bits, see status_bit
+  const size_t STATUS_BIT_NUM = 7;
+
+  /**
+    * This class is the status property of the simplexes, it specializes property<simplex_status>.
+    * Each status bit is stored in its own packed bitset, 64 simplexes in a word, so the status
+    * takes 7 bits per simplex instead of a simplex_status object, and the scans over one flag,
+    * such as skipping the deleted simplexes, go word by word. The bits of a flag are only set by
+    * one thread at a time, since the simplexes in a word share the memory.
+    */
+  template <>
+  class property<simplex_status>: public base_property
+  {
+  public:
+    /// an alias used to define the value type
+    typedef simplex_status value_type;
+
+    /// an alias used to define the word type of the bitsets
+    typedef uint64_t word_type;
+
+    /// the number of the bits in a word
+    static const size_t WORD_BITS = 64;
+
+    /// This member function creates a new instance of this class.
+    property(const std::string& name="<unknown>"): base_property(name), n_(0) {}
+
+    /// copy construct function
+    property(const property& rhs): base_property(rhs.name_), n_(rhs.n_)
+    {
+      for(size_t i = 0; i < STATUS_BIT_NUM; ++i)
+        bits_[i] = rhs.bits_[i];
+    }
+
+    /// This member function destroys an instance of class
+    virtual ~property() {}
+
+    /// This function reserves the size of the property, see base_property
+    virtual void reserve(size_t n)
+    {
+      for(size_t i = 0; i < STATUS_BIT_NUM; ++i)
+        bits_[i].reserve(word_num(n));
+    }
+
+    /// This function resizes the size of the property, see base_property
+    virtual void resize(size_t n)
+    {
+      for(size_t i = 0; i < STATUS_BIT_NUM; ++i)
+        {
+          bits_[i].resize(word_num(n), 0);
+          // the bits after the end are kept 0, so the growing needs no cleanup
+          if(n % WORD_BITS != 0)
+            bits_[i].back() &= (word_type(1) << (n % WORD_BITS)) - 1;
+        }
+      n_ = n;
+    }
+
+    /// This function push back a default property, see base_property
+    virtual void push_back()
+    {
+      if(n_ % WORD_BITS == 0)
+        for(size_t i = 0; i < STATUS_BIT_NUM; ++i)
+          bits_[i].push_back(0);
+      ++n_;
+    }
+
+    /// This function clear the property, see base_property
+    virtual void clear()
+    {
+      for(size_t i = 0; i < STATUS_BIT_NUM; ++i)
+        std::vector<word_type>().swap(bits_[i]);
+      n_ = 0;
+    }
+
+    /// This function swap two properties, see base_property
+    virtual void swap(size_t id0, size_t id1)
+    {
+      const unsigned int st0 = get_status(id0);
+      set_status(id0, get_status(id1));
+      set_status(id1, st0);
+    }
+
+    /// This function resets a property to the default value, see base_property
+    virtual void reset(size_t id) {set_status(id, 0);}
+
+    /// This function return the number of the element of the current property, see base_property
+    virtual size_t n_elements() const {return n_;}
+
+    /// This function returns the memory allocated by the property, see base_property
+    virtual size_t memory_usage() const
+    {
+      size_t bytes = 0;
+      for(size_t i = 0; i < STATUS_BIT_NUM; ++i)
+        bytes += bits_[i].capacity() * sizeof(word_type);
+      return bytes;
+    }
+
+    /// This function clone the current property, see base_property
+    virtual base_property* clone() const
+    {
+      property<simplex_status>* p = new property(*this);
+      assert(p != NULL);
+      return p;
+    }
+
+    /** This function returns the status of the given index, the flags are gathered into a copy
+      * \param id the given index
+      * \return the status whose index is id
+      */
+    simplex_status operator[] (size_t id) const
+    {
+      simplex_status st;
+      st.set_status(get_status(id));
+      return st;
+    }
+
+    /** This function returns all the flags of the given index as status_bit values
+      * \param id the given index
+      * \return the flags whose index is id
+      */
+    unsigned int get_status(size_t id) const
+    {
+      assert(id < n_);
+      unsigned int st = 0;
+      for(size_t i = 0; i < STATUS_BIT_NUM; ++i)
+        st |= unsigned((bits_[i][id / WORD_BITS] >> (id % WORD_BITS)) & 1) << i;
+      return st;
+    }
+
+    /** This function updates all the flags of the given index
+      * \param id the given index
+      * \param st the flags as status_bit values
+      */
+    void set_status(size_t id, unsigned int st)
+    {
+      assert(id < n_);
+      const word_type mask = word_type(1) << (id % WORD_BITS);
+      for(size_t i = 0; i < STATUS_BIT_NUM; ++i)
+        {
+          word_type& w = bits_[i][id / WORD_BITS];
+          w = (st >> i & 1) ? (w | mask) : (w & ~mask);
+        }
+    }
+
+    /** This function checks if the given index is marked as the flag
+      * \param id the given index
+      * \param flag the given flag, it is one of status_bit
+      * \return true if the index is marked as the flag, otherwise false
+      */
+    bool is_set_flag(size_t id, unsigned int flag) const
+    {
+      assert(id < n_);
+      return (bits_[bit_index(flag)][id / WORD_BITS] >> (id % WORD_BITS)) & 1;
+    }
+
+    /** This function marks the given index as the flag
+      * \param id the given index
+      * \param flag the given flag, it is one of status_bit
+      */
+    void set_flag(size_t id, unsigned int flag)
+    {
+      assert(id < n_);
+      bits_[bit_index(flag)][id / WORD_BITS] |= word_type(1) << (id % WORD_BITS);
+    }
+
+    /** This function removes the flag from the given index
+      * \param id the given index
+      * \param flag the given flag, it is one of status_bit
+      */
+    void reset_flag(size_t id, unsigned int flag)
+    {
+      assert(id < n_);
+      bits_[bit_index(flag)][id / WORD_BITS] &= ~(word_type(1) << (id % WORD_BITS));
+    }
+
+    /** This function returns the number of the indexes marked as the flag
+      * \param flag the given flag, it is one of status_bit
+      * \return the number of the indexes marked as the flag
+      */
+    size_t count_flag(unsigned int flag) const
+    {
+      const std::vector<word_type>& bits = bits_[bit_index(flag)];
+      size_t num = 0;
+      for(size_t i = 0; i < bits.size(); ++i)
+        num += popcount(bits[i]);
+      return num;
+    }
+
+    /** This function finds the first index not before id which is marked as the flag or not
+      * \param flag the given flag, it is one of status_bit
+      * \param id the index the search starts from
+      * \param is_set true to find a marked index, false to find an unmarked one
+      * \return the found index, it is n_elements() if there is no such index
+      */
+    size_t find_next(unsigned int flag, size_t id, bool is_set) const
+    {
+      const std::vector<word_type>& bits = bits_[bit_index(flag)];
+      const word_type flip = is_set ? 0 : ~word_type(0);
+      for(size_t i = id / WORD_BITS; id < n_; ++i, id = i * WORD_BITS)
+        {
+          const word_type w = (bits[i] ^ flip) >> (id % WORD_BITS);
+          if(w != 0)
+            return std::min(id + count_trailing_zeros(w), n_);
+        }
+      return n_;
+    }
+
+    /** This function returns the packed bits of the flag, the bit i % 64 of the word i / 64 is the
+      * flag of the index i, it is used to scan the flag by words
+      * \param flag the given flag, it is one of status_bit
+      * \return the words of the flag
+      */
+    const std::vector<word_type>& get_bits(unsigned int flag) const
+    {return bits_[bit_index(flag)];}
+
+    /** This function writes the property, see write_pod_vector
+      * \param os the output stream
+      * \return 0 if operation suncess othervise non-zero
+      */
+    int write(std::ostream& os) const
+    {
+      const uint64_t n = n_;
+      os.write((const char*)&n, sizeof(n));
+      for(size_t i = 0; i < STATUS_BIT_NUM; ++i)
+        if(write_pod_vector(os, bits_[i]))
+          return __LINE__;
+      return os.fail();
+    }
+
+    /** This function reads the property written by write
+      * \param is the input stream
+      * \return 0 if operation suncess othervise non-zero, the property is empty on failure
+      */
+    int read(std::istream& is)
+    {
+      uint64_t n = 0;
+      is.read((char*)&n, sizeof(n));
+      for(size_t i = 0; i < STATUS_BIT_NUM; ++i)
+        if(is.fail() || read_pod_vector(is, bits_[i]) || bits_[i].size() != word_num(n))
+          {
+            clear();
+            return __LINE__;
+          }
+      resize(n);
+      return 0;
+    }
+
+  private:
+    /// This function returns the number of the words holding n bits
+    static size_t word_num(size_t n)
+    {return (n + WORD_BITS - 1) / WORD_BITS;}
+
+    /// This function returns the position of the bitset of a flag
+    static size_t bit_index(unsigned int flag)
+    {
+      assert(flag != 0 && (flag & (flag - 1)) == 0 && flag < (1u << STATUS_BIT_NUM));
+      return count_trailing_zeros(flag);
+    }
+
+    /// This function returns the number of the set bits of a word
+    static size_t popcount(word_type w)
+    {
+#ifdef __GNUC__
+      return __builtin_popcountll(w);
+#else
+      size_t num = 0;
+      for(; w != 0; w &= w - 1)
+        ++num;
+      return num;
+#endif
+    }
+
+    /// This function returns the number of the trailing zero bits of a word which is not 0
+    static size_t count_trailing_zeros(word_type w)
+    {
+      assert(w != 0);
+#ifdef __GNUC__
+      return __builtin_ctzll(w);
+#else
+      size_t num = 0;
+      for(; (w & 1) == 0; w >>= 1)
+        ++num;
+      return num;
+#endif
+    }
+
+    /// the packed bitsets, one for each status bit
+    std::vector<word_type> bits_[STATUS_BIT_NUM];
+
+    /// the number of the elements
+    size_t n_;
+  };
+}
+
+#endif // IS_STATUS_PROPERTY_H
@@ -0,0 +1,173 @@
+#ifndef IS_INLINE_VECTOR_H
+#define IS_INLINE_VECTOR_H
+
+#include "../common/common.h"
+
+namespace is_mesh
+{
+  /**
+    * This class is a vector with a fixed capacity N whose elements are stored inline, in other words,
+    * it never allocates memory on the heap. It is used to store the boundary and partial co_boundary
+    * of a simplex, whose sizes are bounded by the dimension of the mesh.
+    */
+  template <class T, size_t N>
+  class inline_vector
+  {
+  public:
+    /// an alias used to define the value type
+    typedef T value_type;
+
+    /// an alias used to define the iterator type
+    typedef T* iterator;
+
+    /// an alias used to define the const iterator type
+    typedef const T* const_iterator;
+
+    /// This member function creates a new empty instance of this class.
+    inline_vector():size_(0) {}
+
+    /** This member function creates a new instance of this class from a range
+      * \param first the begin of the range
+      * \param last the end of the range
+      */
+    template <class ITR>
+    inline_vector(ITR first, ITR last):size_(0)
+    {
+      assign(first, last);
+    }
+
+    /** This function returns the capacity of the vector
+      * \return the capacity of the vector
+      */
+    static size_t capacity()
+    {return N;}
+
+    /** This function returns the number of elements of the vector
+      * \return the number of elements of the vector
+      */
+    size_t size() const
+    {return size_;}
+
+    /** This function returns whether the vector is empty
+      * \return true if the vector is empty, otherwise false
+      */
+    bool empty() const
+    {return size_ == 0;}
+
+    /** This function resizes the vector, the new elements are default values
+      * \param n the size we want to resize, it must not be larger than the capacity
+      */
+    void resize(size_t n)
+    {
+      assert(n <= N);
+      for(size_t i = size_; i < n; ++i)
+        data_[i] = T();
+      size_ = n;
+    }
+
+    /** This function does nothing but checks the capacity, it is provided for the compatibility with std::vector
+      * \param n the size we want to reserve
+      */
+    void reserve(size_t n)
+    {
+      assert(n <= N);
+    }
+
+    /// This function clears the vector
+    void clear()
+    {size_ = 0;}
+
+    /** This function push an element into the back of the vector
+      * \param ele the element we want to push
+      */
+    void push_back(const T& ele)
+    {
+      assert(size_ < N);
+      data_[size_++] = ele;
+    }
+
+    /// This function removes the last element of the vector
+    void pop_back()
+    {
+      assert(size_ > 0);
+      --size_;
+    }
+
+    /** This function removes the element at the given position, the following elements are moved forward
+      * \param it the position of the element to be removed
+      * \return the position of the element which follows the removed one
+      */
+    iterator erase(iterator it)
+    {
+      assert(it >= begin() && it < end());
+      std::copy(it + 1, end(), it);
+      --size_;
+      return it;
+    }
+
+    /** This function replaces the content of the vector with a range
+      * \param first the begin of the range
+      * \param last the end of the range
+      */
+    template <class ITR>
+    void assign(ITR first, ITR last)
+    {
+      size_ = 0;
+      for(; first != last; ++first)
+        push_back(*first);
+    }
+
+    /** This function overloads operator [], and returns the element of given index, it is a const version
+      * \param id the given index
+      * \return the element whose index is id
+      */
+    const T& operator[] (size_t id) const
+    {
+      assert(id < size_);
+      return data_[id];
+    }
+
+    /** This function overloads operator [], and returns the element of given index
+      * \param id the given index
+      * \return the element whose index is id
+      */
+    T& operator[] (size_t id)
+    {
+      assert(id < size_);
+      return data_[id];
+    }
+
+    const T& back() const
+    {
+      assert(size_ > 0);
+      return data_[size_ - 1];
+    }
+
+    T& back()
+    {
+      assert(size_ > 0);
+      return data_[size_ - 1];
+    }
+
+    const_iterator begin() const
+    {return data_;}
+
+    iterator begin()
+    {return data_;}
+
+    const_iterator end() const
+    {return data_ + size_;}
+
+    iterator end()
+    {return data_ + size_;}
+
+  private:
+    /// the inline storage of the elements
+    T data_[N];
+
+    /// the number of elements
+    unsigned char size_;
+  };
+}
+
+#endif // IS_INLINE_VECTOR_H
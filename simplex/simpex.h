@@ -3,16 +3,23 @@
 
 #include "../common/common.h"
 #include "simplex_handle.h"
+#include "inline_vector.h"
 
 namespace is_mesh
 {
+  /// the max dimension of the top simplex supported by the mesh
+  const size_t MAX_SIMPLEX_DIM = 3;
+
   /**
     * This class stores the info of a simplex, it consists of all of the boundary simplexes and a partial co_boundary
     * simplex of the simplex. If the simplex is a top one, the parial co_boundary is empty, and if the simplex is a
     * second top one, the partial co_boundary consist of store all the co_boundaries. If the simplex is a vertex, the
     * boundary of it is empty.
+    * The boundary and partial co_boundary are stored inline, the capacity of the boundary is decided by the max
+    * dimension MAX_DIM at compile time, and the partial co_boundary consists of at most two simplexes.
     */
-  class simplex
+  template <size_t MAX_DIM>
+  class basic_simplex
   {
     /// simplex boundary type
     enum boundary_flg_type
@@ -22,12 +29,14 @@ namespace is_mesh
     };
 
   public:
+    /// an alias used to define the boundary type
+    typedef inline_vector<simplex_handle, MAX_DIM + 1> boundary_type;
 
-    /// This member function creates a new instance of this class.
-    simplex() {}
+    /// an alias used to define the partial co_boundary type
+    typedef inline_vector<simplex_handle, 2> par_co_boundary_type;
 
-    /// This member function destroys an instance of class
-    virtual ~simplex() {}
+    /// This member function creates a new instance of this class.
+    basic_simplex() {}
 
     /** this function retruns the size of the boundary of the current simplex
       * \return the boundary size of the current simplex
@@ -104,36 +113,39 @@ namespace is_mesh
       * and it is a const version
       * \return the boundary of the current simplex
       */
-    const std::vector<simplex_handle>& get_boundary() const
+    const boundary_type& get_boundary() const
     {return boundary_;}
 
     /** This function return the boundary of the current simplex
       * \return the boundary of the current simplex
       */
-    std::vector<simplex_handle>& get_boundary()
+    boundary_type& get_boundary()
     {return boundary_;}
 
     /** This function return the partial co_boundary of the current simplex
       * and it is a const version
       * \return the partial co_boundary of the current simplex
       */
-    const std::vector<simplex_handle>& get_par_co_boundary() const
+    const par_co_boundary_type& get_par_co_boundary() const
     {return par_co_boundary_;}
 
     /** This function return the partial co_boundary of the current simplex
       * \return the partial co_boundary of the current simplex
       */
-    std::vector<simplex_handle>& get_par_co_boundary()
+    par_co_boundary_type& get_par_co_boundary()
     {return par_co_boundary_;}
 
   private:
     /// the vector stores the boundary simplex of the current simplex
-    std::vector<simplex_handle> boundary_;
+    boundary_type boundary_;
 
     /// the vector stores the partial co_bounday simplex of the current simplex
-    std::vector<simplex_handle> par_co_boundary_;
+    par_co_boundary_type par_co_boundary_;
   };
 
+  /// an alias used to define the simplex of the mesh whose dimension is not larger than MAX_SIMPLEX_DIM
+  typedef basic_simplex<MAX_SIMPLEX_DIM> simplex;
+
   /// an alias used to define the simplex with the same dimension
   typedef std::vector<simplex> simplex_with_same_dim_type;
 }
@@ -3,6 +3,8 @@
 
 #include "../common/common.h"
 
+#include <stdint.h>
+
 namespace is_mesh
 {
   /// an alias used to define the simplex dimension
@@ -16,50 +18,74 @@ namespace is_mesh
    * This class decribes a handle to a simplex dirctly encoded in the IS data structure. A handle to a simplex
    * is composed by the dimension and position of the simplex.This class is used to extract all the topological
    * relations and to access properties of a simplex.
+   * The dimension and the identifier are packed into a 32-bit integer, the highest DIM_BITS bits store the
+   * dimension and the others store the identifier, so the handle is trivially copyable and the arrays of
+   * handles can be copied and compared as plain integers. The all-ones fields are reserved for null,
+   * so an identifier must be less than ID_MASK, the builders of the mesh fail instead of creating a
+   * simplex beyond it.
    */
   class simplex_handle
   {
   public:
+    /// the number of bits used to store the dimension
+    static const unsigned int DIM_BITS = 3;
+
+    /// the number of bits used to store the identifier
+    static const unsigned int ID_BITS = 32 - DIM_BITS;
+
+    /// the mask of the identifier, it is also the identifier of a null handle
+    static const uint32_t ID_MASK = (uint32_t(1) << ID_BITS) - 1;
+
+    /// the dimension of a null handle
+    static const uint32_t NULL_DIM = (uint32_t(1) << DIM_BITS) - 1;
 
     /// This member function creates a new instance of this class.
     /** In this member function we assign dimension and identifier for the simplex.
       * \param dim the dimension of the simplexto be reffered by the new simplex handle, default value is -1
       * \param id the identifier of the simplexto be reffered by the new simplex handle, default value is -1
       */
-    simplex_handle(simplex_dim dim = -1, simplex_id id = -1):dim_(dim), id_(id) {}
-
-    /// This member function creates a new instance of this class.
-    /** In this function, we create a copy of the input simplex handle
-      * \param rhs the simplex handle to be copied
-      */
-    simplex_handle(const simplex_handle& rhs):dim_(rhs.dim_), id_(rhs.id_){}
-
-    /// This member function destroys an instance of class
-    virtual ~simplex_handle() {}
+    simplex_handle(simplex_dim dim = -1, simplex_id id = -1)
+      :value_(((dim & NULL_DIM) << ID_BITS) | (id & ID_MASK))
+    {
+      assert(dim <= NULL_DIM || dim == simplex_dim(-1));
+      assert(id <= ID_MASK || id == simplex_id(-1));
+    }
 
     /// This member function returns the dimension of the simplex handle
-    /** \return the dimension of the current simplex handle
+    /** \return the dimension of the current simplex handle, it is NULL_DIM for a null handle
       */
     inline simplex_dim dim() const
-    {return dim_;}
+    {return value_ >> ID_BITS;}
 
     /// This member function updates the dimension of the simplex handle
     /** \param dim the dimension to be updated by the current simplex handle
       */
     inline void set_dim(simplex_dim dim)
-    {dim_ = dim;}
+    {
+      assert(dim <= NULL_DIM || dim == simplex_dim(-1));
+      value_ = ((dim & NULL_DIM) << ID_BITS) | (value_ & ID_MASK);
+    }
 
     /// This member function returns the identifier of the simplex handle
-    /** \return the identifier of the current simplex handle
+    /** \return the identifier of the current simplex handle, it is ID_MASK for a null handle
       */
     inline simplex_id id() const
-    {return id_;}
+    {return value_ & ID_MASK;}
 
     /// This member function updates the identifier of the simplex handle
     /** \param id the identifier to be updated by the current simplex handle
       */
     inline void set_id(simplex_id id)
-    {id_ = id;}
+    {
+      assert(id <= ID_MASK || id == simplex_id(-1));
+      value_ = (value_ & ~ID_MASK) | (id & ID_MASK);
+    }
+
+    /// This member function returns the packed value of the simplex handle
+    /** \return the packed dimension and identifier of the current simplex handle
+      */
+    inline uint32_t value() const
+    {return value_;}
 
     /// This operator checks if two simplex handls are equal
     /** In this operator, two simplex handles are equal if and only if the dimension
@@ -69,25 +95,24 @@ namespace is_mesh
       */
     bool operator== (const simplex_handle& rhs) const
     {
-      return (id_ == rhs.id_) && (dim_ == rhs.dim_);
+      return value_ == rhs.value_;
     }
 
     bool operator!= (const simplex_handle& rhs) const
     {
-      return !(*this == rhs);
+      return value_ != rhs.value_;
     }
 
     /// This operator compares two simplex handles
     /** In this operator, we compare two simplex handles, the first handle is the current
-      * one and the second is the input.
+      * one and the second is the input. The dimension is compared first since it is stored
+      * in the highest bits.
       * \param rhs the simplex handle to be compared with the current one
       * \return true if the first handle is less than the second one, othserwise, false.
       */
     bool operator< (const simplex_handle& rhs) const
     {
-      if(dim_ == rhs.dim_)
-        return id_ < rhs.id_;
-      return dim_ < rhs.dim_;
+      return value_ < rhs.value_;
     }
 
     /// This function returns whether the simplex handle is null
@@ -97,15 +122,12 @@ namespace is_mesh
       */
     bool is_null() const
     {
-      return (dim_ == -1 || id_ == -1);
+      return (dim() == NULL_DIM || id() == ID_MASK);
     }
 
   protected:
-    /// The dimension of the reffered simplex
-    simplex_dim dim_;
-
-    /// The identifier of the reffered simplex
-    simplex_id id_;
+    /// The packed dimension and identifier of the reffered simplex
+    uint32_t value_;
   };
 
 }
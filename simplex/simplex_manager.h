@@ -99,6 +99,15 @@ namespace is_mesh
       return mesh_simplices_[dim].size();
     }
 
+    /** This function returns the memory allocated by the simplex with the same dimension
+      * \param dim the simplex dimension of the simplex
+      * \return the memory allocated by the simplex with the same dimension dim in bytes
+      */
+    size_t memory_usage(const simplex_dim& dim) const
+    {
+      return mesh_simplices_[dim].capacity() * sizeof(simplex);
+    }
+
     /** This function clear the simplex with same dimension
       * \param dim the dimension the simplex which we want to clear
       */
@@ -0,0 +1,240 @@
+#include <sxxlib/is_mesh/io/io.h>
+
+#include <cstdlib>
+
+/** This function builds a triangle mesh of an n * n grid of vertexes, each square is split into two
+  * triangles
+  * \param n the number of the vertexes on a side
+  * \param cur_mesh the mesh
+  */
+static void build_tri_grid(size_t n, is_mesh::mesh& cur_mesh)
+{
+  zjucad::matrix::matrix<double> nodes(3, n * n);
+  zjucad::matrix::matrix<size_t> cells(3, 2 * (n - 1) * (n - 1));
+  for(size_t i = 0; i < n; ++i)
+    for(size_t j = 0; j < n; ++j)
+      {
+        nodes(0, i * n + j) = i;
+        nodes(1, i * n + j) = j;
+        nodes(2, i * n + j) = 0;
+      }
+  size_t cnt = 0;
+  for(size_t i = 0; i + 1 < n; ++i)
+    for(size_t j = 0; j + 1 < n; ++j, cnt += 2)
+      {
+        cells(0, cnt) = i * n + j;
+        cells(1, cnt) = (i + 1) * n + j;
+        cells(2, cnt) = (i + 1) * n + j + 1;
+        cells(0, cnt + 1) = i * n + j;
+        cells(1, cnt + 1) = (i + 1) * n + j + 1;
+        cells(2, cnt + 1) = i * n + j + 1;
+      }
+  is_mesh::io::read_mesh(nodes, cells, cur_mesh);
+}
+
+/** This function builds a tet mesh of an n * n * n grid of cubes, each cube is split into six tets
+  * along its diagonal
+  * \param n the number of the cubes on a side
+  * \param cur_mesh the mesh
+  */
+static void build_tet_grid(size_t n, is_mesh::mesh& cur_mesh)
+{
+  const size_t m = n + 1;
+  const size_t paths[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+  zjucad::matrix::matrix<double> nodes(3, m * m * m);
+  zjucad::matrix::matrix<size_t> cells(4, 6 * n * n * n);
+  for(size_t i = 0; i < m * m * m; ++i)
+    {
+      nodes(0, i) = i / (m * m);
+      nodes(1, i) = i / m % m;
+      nodes(2, i) = i % m;
+    }
+  size_t cnt = 0;
+  for(size_t i = 0; i < n * n * n; ++i)
+    for(size_t p = 0; p < 6; ++p, ++cnt)
+      {
+        size_t c[3] = {i / (n * n), i / n % n, i % n};
+        cells(0, cnt) = (c[0] * m + c[1]) * m + c[2];
+        for(size_t k = 0; k < 3; ++k)
+          {
+            ++c[paths[p][k]];
+            cells(k + 1, cnt) = (c[0] * m + c[1]) * m + c[2];
+          }
+      }
+  is_mesh::io::read_mesh(nodes, cells, cur_mesh);
+}
+
+/** This function compares the co_boundary queries of every remaining simplex with a scan over all
+  * the remaining simplexes containing its vertexes
+  * \param cur_mesh the mesh
+  * \param name the name of the case printed with the errors
+  * \return the number of the wrong queries
+  */
+static size_t check_co_boundary(const is_mesh::mesh& cur_mesh, const char* name)
+{
+  const size_t top_dim = cur_mesh.top_dim();
+  std::vector<std::vector<size_t> > offsets(top_dim + 1);
+  std::vector<std::vector<is_mesh::simplex_handle> > verts(top_dim + 1);
+  for(size_t k = 1; k <= top_dim; ++k)
+    cur_mesh.get_k_boundary_relation(k, 0, offsets[k], verts[k]);
+  std::vector<is_mesh::simplex_handle> co_bounds, expected, sh_verts;
+  size_t bad = 0;
+  for(size_t d = 0; d < top_dim; ++d)
+    for(size_t i = 0; i < cur_mesh.n_elements(d); ++i)
+      {
+        const is_mesh::simplex_handle sh(d, i);
+        if(cur_mesh.is_simplex_deleted(sh))
+          continue;
+        if(d == 0)
+          sh_verts.assign(1, sh);
+        else
+          sh_verts.assign(verts[d].begin() + offsets[d][i], verts[d].begin() + offsets[d][i + 1]);
+        size_t all_num = 0;
+        for(size_t k = d + 1; k <= top_dim; ++k)
+          {
+            expected.clear();
+            for(size_t j = 0; j < cur_mesh.n_elements(k); ++j)
+              if(std::includes(verts[k].begin() + offsets[k][j], verts[k].begin() + offsets[k][j + 1],
+                               sh_verts.begin(), sh_verts.end()))
+                expected.push_back(is_mesh::simplex_handle(k, j));
+            all_num += expected.size();
+            cur_mesh.get_k_co_boundary_simplex(sh, k, co_bounds);
+            std::sort(co_bounds.begin(), co_bounds.end());
+            if(co_bounds != expected)
+              {
+                std::cerr << "# [error] " << name << ": the " << k << "-co_boundary of the simplex ("
+                          << d << ", " << i << ") has " << co_bounds.size() << " simplexes, "
+                          << expected.size() << " are expected" << std::endl;
+                ++bad;
+              }
+          }
+        cur_mesh.get_all_co_boundary_simplex(sh, co_bounds);
+        if(co_bounds.size() != all_num)
+          {
+            std::cerr << "# [error] " << name << ": the co_boundary of the simplex (" << d << ", " << i
+                      << ") has " << co_bounds.size() << " simplexes, " << all_num << " are expected"
+                      << std::endl;
+            ++bad;
+          }
+      }
+  return bad;
+}
+
+/** This function deletes the given simplexes, collects the garbage or reorders the mesh and checks
+  * the queries
+  * \param cur_mesh the mesh
+  * \param shs the simplexes to be deleted
+  * \param num the number of the simplexes
+  * \param is_reordered whether the mesh is reordered instead of collected
+  * \param name the name of the case
+  * \return the number of the wrong queries
+  */
+static size_t check_deletion(is_mesh::mesh& cur_mesh, const is_mesh::simplex_handle* shs, size_t num,
+                             bool is_reordered, const char* name)
+{
+  for(size_t i = 0; i < num; ++i)
+    if(!cur_mesh.is_simplex_deleted(shs[i]))
+      cur_mesh.del_simplex(shs[i]);
+  if(is_reordered)
+    cur_mesh.reorder();
+  else
+    cur_mesh.garbage_collector();
+  return check_co_boundary(cur_mesh, name);
+}
+
+/** This function deletes random simplexes of a mesh in several rounds, the garbage is collected or
+  * the mesh is reordered after each round, and the queries are checked
+  * \param cur_mesh the mesh
+  * \param name the name of the case
+  * \return the number of the wrong queries
+  */
+static size_t check_random_deletion(is_mesh::mesh& cur_mesh, const char* name)
+{
+  size_t bad = 0;
+  for(size_t round = 0; round < 3; ++round)
+    {
+      for(size_t i = 0; i < 4; ++i)
+        {
+          const size_t dim = rand() % (cur_mesh.top_dim() + 1);
+          if(cur_mesh.n_elements(dim) == 0)
+            continue;
+          const is_mesh::simplex_handle sh(dim, rand() % cur_mesh.n_elements(dim));
+          if(!cur_mesh.is_simplex_deleted(sh))
+            cur_mesh.del_simplex(sh);
+        }
+      // the collection is also run in small slices, and by reorder
+      if(round == 1)
+        while(!cur_mesh.collect_garbage(5));
+      else if(round == 2)
+        cur_mesh.reorder();
+      else
+        cur_mesh.garbage_collector();
+      bad += check_co_boundary(cur_mesh, name);
+    }
+  return bad;
+}
+
+int main()
+{
+  size_t bad = 0;
+
+  /****************   deletion, garbage collection and reorder   ***************/
+  {
+    // the representative edge of the vertex 5 is deleted
+    is_mesh::mesh cur_mesh;
+    build_tri_grid(4, cur_mesh);
+    const is_mesh::simplex_handle shs[] = {is_mesh::simplex_handle(1, 14)};
+    bad += check_deletion(cur_mesh, shs, 1, false, "tri grid edge");
+  }
+  {
+    is_mesh::mesh cur_mesh;
+    build_tet_grid(3, cur_mesh);
+    const is_mesh::simplex_handle shs[] = {is_mesh::simplex_handle(1, 7), is_mesh::simplex_handle(2, 30)};
+    bad += check_deletion(cur_mesh, shs, 2, false, "tet grid edge and face");
+  }
+  {
+    // the boundary faces of the tet are left without co_boundary
+    is_mesh::mesh cur_mesh;
+    build_tet_grid(3, cur_mesh);
+    const is_mesh::simplex_handle shs[] = {is_mesh::simplex_handle(3, 10)};
+    bad += check_deletion(cur_mesh, shs, 1, false, "tet grid tet");
+  }
+  {
+    // the edges 15, 19 and 57 lose the representative face
+    is_mesh::mesh cur_mesh;
+    build_tet_grid(3, cur_mesh);
+    const is_mesh::simplex_handle shs[] = {is_mesh::simplex_handle(3, 10)};
+    bad += check_deletion(cur_mesh, shs, 1, true, "tet grid tet reordered");
+  }
+  for(unsigned int seed = 0; seed < 20; ++seed)
+    {
+      srand(seed);
+      is_mesh::mesh tri_mesh, tet_mesh;
+      build_tri_grid(6, tri_mesh);
+      bad += check_random_deletion(tri_mesh, "tri grid random");
+      build_tet_grid(2, tet_mesh);
+      bad += check_random_deletion(tet_mesh, "tet grid random");
+    }
+
+  /****************   range of the identifiers   ***************/
+  {
+    // the vertexes are rejected before their coordinates are read
+    is_mesh::mesh cur_mesh;
+    cur_mesh.set_dim(2);
+    const double coord[3] = {0, 0, 0};
+    if(cur_mesh.new_verts(coord, size_t(is_mesh::simplex_handle::ID_MASK) + 1) == 0 ||
+       cur_mesh.n_elements(0) != 0)
+      {
+        std::cerr << "# [error] the vertexes beyond the range of the handles are created" << std::endl;
+        ++bad;
+      }
+  }
+
+  if(bad != 0)
+    {
+      std::cerr << "# [error] " << bad << " checks failed" << std::endl;
+      return 1;
+    }
+  std::cout << "all the checks passed" << std::endl;
+  return 0;
+}
@@ -13,8 +13,8 @@ namespace is_mesh
     const size_t vert_num = cur_mesh_.get_simplex_manager().n_element(0);
     cur_mesh_.new_vert(vert_num, coord, new_vert_sh);
 
-    std::vector<simplex_handle> vert_shs;
-    std::vector<std::vector<simplex_handle> > other_verts;
+    std::vector<simplex_handle>& vert_shs = vert_shs_;
+    std::vector<std::vector<simplex_handle> >& other_verts = other_verts_;
     del_top_simplex(sh, vert_shs, other_verts);
 
     if(sh.dim() == cur_mesh_.top_dim())
@@ -37,17 +37,17 @@ namespace is_mesh
         std::cerr << "the edge can not be collapsed" << std::endl;
         return 1;
       }
-    const std::vector<simplex_handle> edge_verts =
+    const simplex::boundary_type edge_verts =
         cur_mesh_.get_simplex_manager().get_specific_simplex(sh).get_boundary();
     cur_mesh_.set_coord(edge_verts[1], coord);
 
     // deal with some case
-    const std::vector<simplex_handle> edge_tops =
+    const simplex::par_co_boundary_type edge_tops =
         cur_mesh_.get_simplex_manager().get_specific_simplex(sh).get_par_co_boundary();
     std::vector<simplex_handle> del_edges;
     for(size_t i = 0; i < edge_tops.size(); ++i)
       {
-        const std::vector<simplex_handle>& bou =
+        const simplex::boundary_type& bou =
             cur_mesh_.get_simplex_manager().get_specific_simplex(edge_tops[i]).get_boundary();
         std::vector<simplex_handle> other_edges;
         std::vector<bool> is_delete;
@@ -55,7 +55,7 @@ namespace is_mesh
           if(bou[j] != sh)
             {
               other_edges.push_back(bou[j]);
-              const std::vector<simplex_handle>& par =
+              const simplex::par_co_boundary_type& par =
                   cur_mesh_.get_simplex_manager().get_specific_simplex(bou[j]).get_par_co_boundary();
               assert(par.size() > 0 && par.size() < 3);
               if(par.size() == 2)
@@ -67,7 +67,7 @@ namespace is_mesh
         if(is_delete[0] || is_delete[1])
           for(size_t j = 0; j < other_edges.size(); ++j)
             {
-              const std::vector<simplex_handle>& vert =
+              const simplex::boundary_type& vert =
                   cur_mesh_.get_simplex_manager().get_specific_simplex(other_edges[j]).get_boundary();
               if(vert[0] != edge_verts[0] && vert[1] != edge_verts[0])
                 {
@@ -75,7 +75,7 @@ namespace is_mesh
                     {
                       if(vert[k] == edge_verts[1])
                         continue;
-                      std::vector<simplex_handle>& par =
+                      simplex::par_co_boundary_type& par =
                           cur_mesh_.get_simplex_manager().get_specific_simplex(vert[k]).get_par_co_boundary();
                       assert(par.size() == 1);
                       par[0] = other_edges[j];
@@ -87,8 +87,8 @@ namespace is_mesh
       }
 
 
-    std::vector<simplex_handle> vert_shs;
-    std::vector<std::vector<simplex_handle> > other_verts;
+    std::vector<simplex_handle>& vert_shs = vert_shs_;
+    std::vector<std::vector<simplex_handle> >& other_verts = other_verts_;
     del_top_simplex(edge_verts[0], vert_shs, other_verts);
     for(size_t i = 0; i < del_edges.size(); ++i)
       {
@@ -96,7 +96,8 @@ namespace is_mesh
         cur_mesh_.set_simplex_deleted(del_edges[i]);
       }
 
-    std::vector<simplex_handle> new_top(cur_mesh_.top_dim() + 1);
+    std::vector<simplex_handle>& new_top = new_top_;
+    new_top.resize(cur_mesh_.top_dim() + 1);
     simplex_handle new_top_sh;
 
     new_top[0] = edge_verts[1];
@@ -118,11 +119,12 @@ namespace is_mesh
         std::cerr << "the edge can not be flipped" << std::endl;
         return 1;
       }
-    std::vector<simplex_handle> vert_shs;
-    std::vector<std::vector<simplex_handle> > other_verts;
+    std::vector<simplex_handle>& vert_shs = vert_shs_;
+    std::vector<std::vector<simplex_handle> >& other_verts = other_verts_;
     del_top_simplex(sh, vert_shs, other_verts);
 
-    std::vector<simplex_handle> new_top(cur_mesh_.top_dim() + 1);
+    std::vector<simplex_handle>& new_top = new_top_;
+    new_top.resize(cur_mesh_.top_dim() + 1);
     simplex_handle new_top_sh;
     new_top[0] = other_verts[0][0];
     new_top[1] = other_verts[1][0];
@@ -139,7 +141,8 @@ namespace is_mesh
                                               const std::vector<simplex_handle>& vert_shs,
                                               const std::vector<std::vector<simplex_handle> >& other_verts)
   {
-    std::vector<simplex_handle> new_top(vert_shs);
+    std::vector<simplex_handle>& new_top = new_top_;
+    new_top.assign(vert_shs.begin(), vert_shs.end());
     simplex_handle new_top_sh;
     for(size_t i = 0; i < vert_shs.size(); ++i)
       {
@@ -155,7 +158,8 @@ namespace is_mesh
                                                  const std::vector<simplex_handle>& vert_shs,
                                                  const std::vector<std::vector<simplex_handle> >& other_verts)
   {
-    std::vector<simplex_handle> new_top(cur_mesh_.top_dim() + 1);
+    std::vector<simplex_handle>& new_top = new_top_;
+    new_top.resize(cur_mesh_.top_dim() + 1);
     simplex_handle new_top_sh;
     if(cur_mesh_.top_dim() == 2)
       {
@@ -192,7 +196,8 @@ namespace is_mesh
                                              const std::vector<simplex_handle>& vert_shs,
                                              const std::vector<std::vector<simplex_handle> >& other_verts)
   {
-    std::vector<simplex_handle> new_top(cur_mesh_.top_dim() + 1);
+    std::vector<simplex_handle>& new_top = new_top_;
+    new_top.resize(cur_mesh_.top_dim() + 1);
     simplex_handle new_top_sh;
     new_top[0] = v_sh;
     for(size_t i = 0; i < other_verts.size(); ++i)
@@ -213,37 +218,36 @@ namespace is_mesh
                                           std::vector<std::vector<simplex_handle> >& other_verts)
   {
     vert_shs.clear();
-    other_verts.clear();
     if(sh.dim() > 0)
       cur_mesh_.get_k_boundary_simplex(sh, 0, vert_shs);
     else
       vert_shs.push_back(sh);
     assert(vert_shs.size() == sh.dim() + 1);
-    std::vector<simplex_handle> adj_top;
+    std::vector<simplex_handle>& adj_top = adj_top_;
+    adj_top.clear();
     if(sh.dim() < cur_mesh_.top_dim())
       cur_mesh_.get_k_co_boundary_simplex(sh, cur_mesh_.top_dim(), adj_top);
     else
       adj_top.push_back(sh);
-    other_verts.reserve(adj_top.size());
+    // the inner vectors are kept by resize, so their memory is reused by the next operation
+    other_verts.resize(adj_top.size());
 
-    std::vector<simplex_handle> del_simplex;
+    std::vector<simplex_handle>& del_simplex = del_shs_;
     cur_mesh_.get_all_co_boundary_simplex(sh, del_simplex);
     del_simplex.push_back(sh);
     for(size_t i = 0; i < adj_top.size(); ++i)
       {
-        std::vector<simplex_handle> other;
-        cur_mesh_.get_other_verts(adj_top[i], vert_shs, other);
-        assert(other.size() == cur_mesh_.top_dim() - sh.dim());
-        other_verts.push_back(other);
-        const std::vector<simplex_handle>& bounds =
+        cur_mesh_.get_other_verts(adj_top[i], vert_shs, other_verts[i]);
+        assert(other_verts[i].size() == cur_mesh_.top_dim() - sh.dim());
+        const simplex::boundary_type& bounds =
             cur_mesh_.get_simplex_manager().get_specific_simplex(adj_top[i]).get_boundary();
         assert(bounds.size() == cur_mesh_.top_dim() + 1);
         for(size_t j = 0; j < bounds.size(); ++j)
           {
-            std::vector<simplex_handle>& co_bound =
+            simplex::par_co_boundary_type& co_bound =
                 cur_mesh_.get_simplex_manager().get_specific_simplex(bounds[j]).get_par_co_boundary();
             assert(co_bound.size() <= 2);
-            std::vector<simplex_handle>::iterator it = co_bound.begin();
+            simplex::par_co_boundary_type::iterator it = co_bound.begin();
             for(; it != co_bound.end(); ++it)
               if(*it == adj_top[i])
                 break;
@@ -263,7 +267,7 @@ namespace is_mesh
 
   bool topology_operation::is_edge_collapse_ok(const simplex_handle &sh)
   {
-    const std::vector<simplex_handle>& edge_verts =
+    const simplex::boundary_type& edge_verts =
         cur_mesh_.get_simplex_manager().get_specific_simplex(sh).get_boundary();
     std::vector<simplex_handle> vert1_adj_top, vert2_adj_top, edge_adj_top;
     cur_mesh_.get_k_co_boundary_simplex(edge_verts[0], cur_mesh_.top_dim(), vert1_adj_top);
@@ -290,9 +294,16 @@ namespace is_mesh
 
     matrixst new_cells(cur_mesh_.top_dim() + 1, only_vert_top.size());
     int t;
+    std::vector<simplex_handle> bounds;
     for(size_t i = 0; i < only_vert_top.size(); ++i)
       {
-        std::vector<simplex_handle> bounds;
+        if(cur_mesh_.is_top_verts_cached())
+          {
+            const size_t* verts = cur_mesh_.get_top_simplex_verts(only_vert_top[i]);
+            for(size_t j = 0; j <= cur_mesh_.top_dim(); ++j)
+              new_cells(j, i) = (verts[j] == edge_verts[0].id() ? edge_verts[1].id() : verts[j]);
+            continue;
+          }
         cur_mesh_.get_k_boundary_simplex(only_vert_top[i], 0, bounds);
         for(size_t j = 0; j < bounds.size(); ++j)
           {
@@ -313,7 +324,7 @@ namespace is_mesh
     assert(cur_mesh_.is_valid_handle(sh));
     assert(sh.dim() == 1);
     assert(!cur_mesh_.is_simplex_deleted(sh));
-    const std::vector<simplex_handle>& top =
+    const simplex::par_co_boundary_type& top =
         cur_mesh_.get_simplex_manager().get_specific_simplex(sh).get_par_co_boundary();
     assert(top.size() > 0 && top.size() < 3);
     if(top.size() != 2)
@@ -321,11 +332,13 @@ namespace is_mesh
         std::cerr << "it is a boundary edge" << std::endl;
         return false;
       }
-    const std::vector<simplex_handle>& edge_vert =
+    const simplex::boundary_type& edge_bound =
         cur_mesh_.get_simplex_manager().get_specific_simplex(sh).get_boundary();
+    const std::vector<simplex_handle> edge_vert(edge_bound.begin(), edge_bound.end());
     std::vector<simplex_handle> other_verts;
-    std::vector<size_t> others(2);
+    size_t others[2] = {0, 0};
 
+    assert(top.size() == 2);
     for(size_t i = 0; i < top.size(); ++i)
       {
         cur_mesh_.get_other_verts(top[i], edge_vert, other_verts);
@@ -338,8 +351,7 @@ namespace is_mesh
       std::swap(others[0], others[1]);
     const mesh::simplex2handle_type& simplex2handle =
         cur_mesh_.get_simplex2handle();
-    if(simplex2handle[sh.dim()].find(others) !=
-       simplex2handle[sh.dim()].end())
+    if(!simplex2handle[sh.dim()].find(simplex_key(others, 2)).is_null())
       return false;
     return true;
   }
@@ -37,6 +37,18 @@ namespace is_mesh
       */
     int flip_edge(const simplex_handle& sh);
 
+    /** This function tests whether an edge can be collapsed, see collapse_edge
+      * \param sh the handle of given edge
+      * \return true if the edge can be collapsed, otherwise false
+      */
+    bool is_edge_collapse_ok(const simplex_handle& sh);
+
+    /** This function tests whether an edge can be flipped, see flip_edge
+      * \param sh the handle of given edge
+      * \return true if the edge can be flipped, otherwise false
+      */
+    bool is_edge_flip_ok(const simplex_handle& sh);
+
   protected:
 
     int del_top_simplex(const simplex_handle& sh,
@@ -55,10 +67,6 @@ namespace is_mesh
                            const std::vector<simplex_handle>& vert_shs,
                            const std::vector<std::vector<simplex_handle> >& other_verts);
 
-    bool is_edge_collapse_ok(const simplex_handle& sh);
-
-    bool is_edge_flip_ok(const simplex_handle& sh);
-
     template<typename T>
     bool is_in(const std::vector<T>& vec, const T& ele)
     {
@@ -74,6 +82,12 @@ namespace is_mesh
 
   protected:
     mesh& cur_mesh_;
+
+    /// the scratch buffers of the operations, they keep their memory between the operations
+    std::vector<simplex_handle> vert_shs_, new_top_, adj_top_, del_shs_;
+
+    /// the scratch buffer of the other vertexes of the deleted top simplexes
+    std::vector<std::vector<simplex_handle> > other_verts_;
   };
 }
 